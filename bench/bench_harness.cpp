@@ -0,0 +1,161 @@
+#include "bench_harness.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTextStream>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// ---------------- allocation counting ----------------
+
+namespace {
+std::atomic<quint64> g_allocs{0};
+std::atomic<quint64> g_allocBytes{0};
+
+inline void countAlloc(std::size_t n) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(n, std::memory_order_relaxed);
+}
+}
+
+#if defined(__GLIBC__)
+// Interpose the C allocator so QByteArray/QVector growth is counted too.
+extern "C" {
+void *__libc_malloc(std::size_t);
+void *__libc_calloc(std::size_t, std::size_t);
+void *__libc_realloc(void *, std::size_t);
+
+void *malloc(std::size_t n) {
+    countAlloc(n);
+    return __libc_malloc(n);
+}
+void *calloc(std::size_t k, std::size_t n) {
+    countAlloc(k * n);
+    return __libc_calloc(k, n);
+}
+void *realloc(void *p, std::size_t n) {
+    countAlloc(n);
+    return __libc_realloc(p, n);
+}
+}
+#define KD_BENCH_COUNT_NEW 0 // operator new ends up in malloc above
+#else
+#define KD_BENCH_COUNT_NEW 1
+#endif
+
+void *operator new(std::size_t n) {
+#if KD_BENCH_COUNT_NEW
+    countAlloc(n);
+#endif
+    if (void *p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t n) { return operator new(n); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace Bench {
+
+AllocStats allocStats() {
+    return {g_allocs.load(std::memory_order_relaxed), g_allocBytes.load(std::memory_order_relaxed)};
+}
+
+bool countsMalloc() { return !KD_BENCH_COUNT_NEW; }
+
+// ---------------- Run ----------------
+
+Run::Run(const QString &name, const QString &param, const QString &unit) {
+    m_r.name = name;
+    m_r.param = param;
+    m_r.unit = unit;
+    m_start = allocStats();
+}
+
+Result Run::finish() {
+    const AllocStats now = allocStats();
+    m_r.allocs = now.count - m_start.count;
+    m_r.allocBytes = now.bytes - m_start.bytes;
+    return m_r;
+}
+
+// ---------------- Reporter ----------------
+
+void Reporter::add(const Result &r) {
+    m_results.append(r);
+    std::printf("%-28s %-12s %10lld %-6s %10.1f ns/%-6s %8.3f allocs/%-6s %12.0f %s/s  worst=%lld ns\n",
+                qPrintable(r.name), qPrintable(r.param), static_cast<long long>(r.items), qPrintable(r.unit),
+                r.nsPerItem(), qPrintable(r.unit), r.allocsPerItem(), qPrintable(r.unit),
+                r.itemsPerSec(), qPrintable(r.unit), static_cast<long long>(r.worstNs));
+    std::fflush(stdout);
+}
+
+void Reporter::note(const QString &line) {
+    std::printf("%-28s %s\n", "", qPrintable(line));
+}
+
+bool Reporter::writeJson(const QString &path, const QString &label) const {
+    QJsonArray rows;
+    for (const Result &r : m_results) {
+        rows.append(QJsonObject{
+            {"name", r.name},
+            {"param", r.param},
+            {"unit", r.unit},
+            {"items", double(r.items)},
+            {"calls", double(r.calls)},
+            {"totalNs", double(r.totalNs)},
+            {"worstNs", double(r.worstNs)},
+            {"nsPerItem", r.nsPerItem()},
+            {"allocs", double(r.allocs)},
+            {"allocBytes", double(r.allocBytes)},
+            {"allocsPerItem", r.allocsPerItem()},
+        });
+    }
+    QJsonObject root{
+        {"label", label},
+        {"time", QDateTime::currentDateTime().toString(Qt::ISODate)},
+        {"qt", QString::fromLatin1(qVersion())},
+        {"cpu", QSysInfo::currentCpuArchitecture()},
+        {"os", QSysInfo::prettyProductName()},
+#ifdef QT_DEBUG
+        {"build", "debug"},
+#else
+        {"build", "release"},
+#endif
+        {"countsMalloc", countsMalloc()},
+        {"results", rows},
+    };
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::fprintf(stderr, "cannot write %s\n", qPrintable(path));
+        return false;
+    }
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+bool Reporter::writeCsv(const QString &path, const QString &label) const {
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        std::fprintf(stderr, "cannot write %s\n", qPrintable(path));
+        return false;
+    }
+    QTextStream out(&f);
+    out << "label,name,param,unit,items,calls,total_ns,worst_ns,ns_per_item,allocs,alloc_bytes,allocs_per_item\n";
+    for (const Result &r : m_results) {
+        out << label << ',' << r.name << ',' << r.param << ',' << r.unit << ','
+            << r.items << ',' << r.calls << ',' << r.totalNs << ',' << r.worstNs << ','
+            << r.nsPerItem() << ',' << r.allocs << ',' << r.allocBytes << ','
+            << r.allocsPerItem() << '\n';
+    }
+    return true;
+}
+
+} // namespace Bench
@@ -0,0 +1,90 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Minimal benchmark harness for keydash_bench: per-call timing, heap
+// allocation counting and table / JSON / CSV reporting.
+namespace Bench {
+
+// Heap allocations made by the whole process so far. Counts malloc/calloc/
+// realloc (which is where Qt containers allocate) on glibc, and operator new
+// everywhere else.
+struct AllocStats {
+    quint64 count = 0;
+    quint64 bytes = 0;
+};
+AllocStats allocStats();
+bool countsMalloc(); // false: only operator new is seen
+
+struct Result {
+    QString name;
+    QString param;    // variant, e.g. "chunk=1024"
+    QString unit;     // what one item is: "frame", "line", "sample", "row"
+    qint64  items = 0;
+    qint64  calls = 0;
+    qint64  totalNs = 0;
+    qint64  worstNs = 0; // slowest single timed call
+    quint64 allocs = 0;
+    quint64 allocBytes = 0;
+
+    double nsPerItem() const { return items ? double(totalNs) / double(items) : 0.0; }
+    double allocsPerItem() const { return items ? double(allocs) / double(items) : 0.0; }
+    double itemsPerSec() const { return totalNs ? double(items) * 1e9 / double(totalNs) : 0.0; }
+};
+
+// Collects one Result: wrap every timed call in begin()/end(items).
+// Allocations are counted from construction to finish(), so keep setup
+// outside the Run's lifetime.
+class Run {
+  public:
+    Run(const QString &name, const QString &param, const QString &unit);
+    void begin() { m_timer.start(); }
+    void end(qint64 items) {
+        const qint64 ns = m_timer.nsecsElapsed();
+        m_r.totalNs += ns;
+        m_r.worstNs = qMax(m_r.worstNs, ns);
+        m_r.items += items;
+        ++m_r.calls;
+    }
+    Result finish();
+
+  private:
+    Result        m_r;
+    AllocStats    m_start;
+    QElapsedTimer m_timer;
+};
+
+// Chunked stream helper: feed(data, len) returns the items it decoded.
+template <typename Feed>
+Result runChunked(const QString &name, const QString &unit, const QByteArray &stream, int chunk, Feed &&feed) {
+    Run run(name, QStringLiteral("chunk=%1").arg(chunk), unit);
+    for (qsizetype off = 0; off < stream.size(); off += chunk) {
+        const qsizetype n = qMin<qsizetype>(chunk, stream.size() - off);
+        run.begin();
+        const qint64 items = feed(stream.constData() + off, n);
+        run.end(items);
+    }
+    return run.finish();
+}
+
+class Reporter {
+  public:
+    explicit Reporter(const QString &filter = QString()) : m_filter(filter) {}
+
+    // Benchmarks whose name does not contain the filter are skipped.
+    bool wants(const QString &name) const { return m_filter.isEmpty() || name.contains(m_filter, Qt::CaseInsensitive); }
+
+    void add(const Result &r); // also prints a table row
+    void note(const QString &line);
+
+    bool writeJson(const QString &path, const QString &label) const;
+    bool writeCsv(const QString &path, const QString &label) const;
+
+  private:
+    QString m_filter;
+    QVector<Result> m_results;
+};
+
+} // namespace Bench
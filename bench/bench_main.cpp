@@ -0,0 +1,610 @@
+// keydash_bench: micro-benchmarks for the decode, model and logging hot paths.
+// Build with -DKEYDASH_BUILD_BENCH=ON and run ./keydash_bench [options]:
+//
+//   --filter <text>   only benchmarks whose name contains <text>
+//   --json <file>     write results as JSON (for diffing between commits)
+//   --csv <file>      write results as CSV
+//   --label <text>    tag stored with the results (e.g. a commit hash)
+//   --dbc <file>      DBC for the CAN benchmarks (default: synthetic broadcast)
+//   --can-log <file>  CAN traffic for them: candump -l log or .kdcap, e.g.
+//                     recorded on vcan0 (default: synthetic frames)
+//   --vcan <iface>    also time CAN receive (QtSerialBus vs native SocketCAN)
+//                     on a live interface, e.g. after
+//                     "ip link add vcan0 type vcan && ip link set up vcan0"
+//
+// Every result reports ns and heap allocations per item; see bench_harness.h.
+
+#include <QByteArray>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTemporaryFile>
+#include <QFile>
+#include <QHash>
+#include <QVector>
+#include <QXmlStreamReader>
+#include <QtGlobal>
+#include <cstdio>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <linux/can.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "bench/bench_harness.h"
+#include "bench/generators.h"
+#include "dashmodel.h"
+#include "core/itransport.h"
+#include "logging/csv_row.h"
+#include "protocols/dbc_can_protocol.h"
+#include "protocols/dbc_database.h"
+#include "protocols/ecumaster_channel_map.h"
+#include "protocols/ecumaster_classic.h"
+#include "protocols/ecumaster_frame_decoder.h"
+#include "protocols/obd2_elm327.h"
+#include "transports/can_transport.h"
+#include "transports/replay_transport.h"
+#include "transports/socketcan_transport.h"
+#include "transports/serial_transport.h"
+
+using namespace Bench;
+
+namespace {
+
+// ---------------- legacy decoder (baseline EcuReader) ----------------
+// Verbatim copy of the pre-ring tryExtractFrame() so both paths can be timed
+// against the same input.
+
+struct LegacyDecoder {
+    QByteArray buf;
+
+    static bool checksumOk(quint8 ch, quint8 vh, quint8 vl, quint8 cs, int mod) {
+        return ((int(ch) + 0xA3 + int(vh) + int(vl)) % mod) == cs;
+    }
+
+    bool tryExtractFrame(int &ch, quint8 &vh, quint8 &vl, quint8 &cs) {
+        for (int i = 0; i + 5 <= buf.size(); ++i) {
+            const uchar B0 = uchar(buf[i + 0]);
+            const uchar B1 = uchar(buf[i + 1]);
+            const uchar B2 = uchar(buf[i + 2]);
+            const uchar B3 = uchar(buf[i + 3]);
+            const uchar B4 = uchar(buf[i + 4]);
+            if (B1 != 0xA3)
+                continue;
+            const bool ok256 = checksumOk(B0, B2, B3, B4, 256);
+            const bool ok255 = !ok256 && checksumOk(B0, B2, B3, B4, 255);
+            if (!ok256 && !ok255)
+                continue;
+            ch = int(B0);
+            vh = B2;
+            vl = B3;
+            cs = B4;
+            buf.remove(0, i + 5);
+            return true;
+        }
+        if (buf.size() > 4096)
+            buf.remove(0, buf.size() - 1024);
+        return false;
+    }
+
+    template <typename Fn> int feed(const char *data, qsizetype len, Fn &&onFrame) {
+        buf.append(data, len);
+        int     n = 0, ch;
+        quint8  vh, vl, cs;
+        while (tryExtractFrame(ch, vh, vl, cs)) {
+            onFrame(ch, vh, vl);
+            ++n;
+        }
+        return n;
+    }
+};
+
+// Pre-table channel map + decode (baseline EcuReader::parseIncoming path).
+struct LegacyChannelInfo {
+    QString name;
+    QString storage;
+    double  divider = 1;
+    double  offset  = 0;
+    QString unit;
+};
+
+struct LegacyChannelMap {
+    QHash<int, LegacyChannelInfo> chmap;
+    mutable qsizetype nameSink = 0; // keeps the name test from being optimised out
+
+    bool load(const QString &path) {
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly))
+            return false;
+        QXmlStreamReader xr(&f);
+        while (!xr.atEnd()) {
+            xr.readNext();
+            if (xr.isStartElement() && xr.name() == QLatin1String("symbol")) {
+                auto a = xr.attributes();
+                if (!a.hasAttribute("channel"))
+                    continue;
+                LegacyChannelInfo ci;
+                ci.name    = a.value("name").toString();
+                ci.storage = a.value("storage").toString();
+                ci.unit    = a.value("unit").toString();
+                ci.divider =
+                    a.hasAttribute("divider") ? a.value("divider").toString().toDouble() : 1.0;
+                ci.offset = a.hasAttribute("offset") ? a.value("offset").toString().toDouble() : 0.0;
+                chmap.insert(a.value("channel").toInt(), ci);
+            }
+        }
+        return !xr.hasError();
+    }
+
+    static qint32 decodeRaw(const QString &storage, quint8 vh, quint8 vl) {
+        const QString s = storage.toLower();
+        if (s == "word" || s == "sword") {
+            quint16 u = (quint16(vh) << 8) | vl;
+            if (s == "sword")
+                return (u & 0x8000) ? (qint32(u) - 0x10000) : qint32(u);
+            return qint32(u);
+        }
+        qint32 u8 = vl;
+        if (s == "sbyte")
+            return (u8 & 0x80) ? (u8 - 0x100) : u8;
+        return u8;
+    }
+
+    static double scaleValue(const LegacyChannelInfo &info, qint32 raw) {
+        double v = raw;
+        if (info.divider != 0.0)
+            v /= info.divider;
+        v += info.offset;
+        return v;
+    }
+
+    // parseIncoming() body + the name test at the top of applyChannel()
+    double apply(int ch, quint8 vh, quint8 vl) const {
+        const LegacyChannelInfo info =
+            chmap.value(ch, LegacyChannelInfo{QString(), "word", 1.0, 0.0, QString()});
+        const double    v  = scaleValue(info, decodeRaw(info.storage, vh, vl));
+        const QString   nm = chmap.value(ch).name.toLower();
+        if (nm.contains("baro") || nm.contains("atmo"))
+            nameSink += nm.size();
+        return v;
+    }
+};
+
+void benchClassicDecoder(Reporter &rep) {
+    const QByteArray stream = makeClassicStream(200000, 0.02);
+    volatile int     sink   = 0;
+
+    for (int chunk : {64, 1024, 16384}) {
+        if (rep.wants("legacy tryExtractFrame")) {
+            LegacyDecoder legacy;
+            rep.add(runChunked("legacy tryExtractFrame", "frame", stream, chunk, [&](const char *d, qsizetype n) {
+                return legacy.feed(d, n, [&](int ch, quint8, quint8) { sink = sink + ch; });
+            }));
+        }
+        if (rep.wants("ring decoder")) {
+            EcuMasterFrameDecoder ring;
+            rep.add(runChunked("ring decoder", "frame", stream, chunk, [&](const char *d, qsizetype n) {
+                return ring.feed(d, n, [&](const EcuMasterFrameDecoder::Frame &f) { sink = sink + f.ch; });
+            }));
+        }
+    }
+}
+
+// Full channel path: frame decode + channel map + slot dispatch, and the
+// native protocol (decode + map + batch emission) fed through bytesIn.
+void benchClassicChannelPath(Reporter &rep) {
+    const QString    mapPath = EcuMasterClassicProtocol::defaultMapPath();
+    const QByteArray stream  = makeClassicStream(200000, 0.0);
+    volatile double  sink    = 0;
+    const int        chunk   = 1024;
+
+    LegacyChannelMap legacyMap;
+    if (!legacyMap.load(mapPath)) {
+        rep.note(QStringLiteral("cannot load %1").arg(mapPath));
+        return;
+    }
+    if (rep.wants("legacy parseIncoming")) {
+        LegacyDecoder legacy;
+        rep.add(runChunked("legacy parseIncoming", "frame", stream, chunk, [&](const char *d, qsizetype n) {
+            return legacy.feed(d, n, [&](int ch, quint8 vh, quint8 vl) { sink = sink + legacyMap.apply(ch, vh, vl); });
+        }));
+    }
+
+    EcuMasterChannelMap map;
+    QFile               f(mapPath);
+    if (!f.open(QIODevice::ReadOnly) || !map.load(&f))
+        return;
+    if (rep.wants("ring + channel table")) {
+        EcuMasterFrameDecoder ring;
+        rep.add(runChunked("ring + channel table", "frame", stream, chunk, [&](const char *d, qsizetype n) {
+            return ring.feed(d, n, [&](const EcuMasterFrameDecoder::Frame &fr) {
+                if (map[fr.ch].slot != EcuMasterChannelMap::Slot::None)
+                    sink = sink + map.decode(fr.ch, fr.vh, fr.vl);
+            });
+        }));
+    }
+
+    if (rep.wants("EcuMasterClassicProtocol")) {
+        SerialTransport          port(QStringLiteral("bench"), 115200); // never opened
+        EcuMasterClassicProtocol proto;
+        if (!proto.probe(&port) || !proto.start(&port))
+            return;
+        qint64 samples = 0;
+        QObject::connect(&proto, &IECUProtocol::batch, [&](const SignalBatch &b) { samples += b.size(); });
+        rep.add(runChunked("EcuMasterClassicProtocol", "frame", stream, chunk, [&](const char *d, qsizetype n) {
+            const quint64 before = proto.decoderStats().frames;
+            emit port.bytesIn(QByteArray::fromRawData(d, n));
+            return qint64(proto.decoderStats().frames - before);
+        }));
+        rep.note(QStringLiteral("samples emitted=%1").arg(samples));
+    }
+}
+
+// decodeRaw + scaleValue for already-framed payloads: QString storage
+// compare + hash lookup (legacy) vs the compiled 256-entry table.
+void benchDecodeScale(Reporter &rep) {
+    const QString mapPath = EcuMasterClassicProtocol::defaultMapPath();
+    LegacyChannelMap legacyMap;
+    EcuMasterChannelMap map;
+    QFile f(mapPath);
+    if (!legacyMap.load(mapPath) || !f.open(QIODevice::ReadOnly) || !map.load(&f)) {
+        rep.note(QStringLiteral("cannot load %1").arg(mapPath));
+        return;
+    }
+
+    struct Payload { quint8 ch, vh, vl; };
+    QVector<Payload> frames;
+    EcuMasterFrameDecoder ring;
+    const QByteArray stream = makeClassicStream(200000, 0.0);
+    ring.feed(stream.constData(), stream.size(), [&](const EcuMasterFrameDecoder::Frame &fr) {
+        frames.append({fr.ch, fr.vh, fr.vl});
+    });
+
+    constexpr int kBlock = 4096;
+    volatile double sink = 0;
+    if (rep.wants("legacy decodeRaw+scaleValue")) {
+        Run run("legacy decodeRaw+scaleValue", QStringLiteral("block=%1").arg(kBlock), "value");
+        for (int i = 0; i < frames.size(); i += kBlock) {
+            const int end = qMin(i + kBlock, int(frames.size()));
+            run.begin();
+            double acc = 0;
+            for (int k = i; k < end; ++k) {
+                const LegacyChannelInfo info =
+                    legacyMap.chmap.value(frames[k].ch, LegacyChannelInfo{QString(), "word", 1.0, 0.0, QString()});
+                acc += LegacyChannelMap::scaleValue(info, LegacyChannelMap::decodeRaw(info.storage, frames[k].vh, frames[k].vl));
+            }
+            run.end(end - i);
+            sink = sink + acc;
+        }
+        rep.add(run.finish());
+    }
+    if (rep.wants("table decodeRaw+scaleValue")) {
+        Run run("table decodeRaw+scaleValue", QStringLiteral("block=%1").arg(kBlock), "value");
+        for (int i = 0; i < frames.size(); i += kBlock) {
+            const int end = qMin(i + kBlock, int(frames.size()));
+            run.begin();
+            double acc = 0;
+            for (int k = i; k < end; ++k)
+                acc += map.decode(frames[k].ch, frames[k].vh, frames[k].vl);
+            run.end(end - i);
+            sink = sink + acc;
+        }
+        rep.add(run.finish());
+    }
+}
+
+// ELM327 response line -> PID values
+void benchElmParseLine(Reporter &rep) {
+    if (!rep.wants("OBD2 parseLine")) return;
+    const QVector<QByteArray> lines = makeElmResponses(200000);
+    constexpr int kBlock = 1024;
+    volatile int sink = 0;
+
+    Run run("OBD2 parseLine", QStringLiteral("block=%1").arg(kBlock), "line");
+    OBD2Elm327Protocol::PidValue vals[16];
+    qint64 values = 0;
+    for (int i = 0; i < lines.size(); i += kBlock) {
+        const int end = qMin(i + kBlock, int(lines.size()));
+        run.begin();
+        int got = 0;
+        for (int k = i; k < end; ++k)
+            got += OBD2Elm327Protocol::parseLine(lines[k], vals, 16);
+        run.end(end - i);
+        values += got;
+        sink = sink + got;
+    }
+    rep.add(run.finish());
+    rep.note(QStringLiteral("pid values parsed=%1").arg(values));
+}
+
+// Normalized samples into the QML-facing model
+void benchDashModel(Reporter &rep) {
+    const SignalBatch batch = makeSignalBatch(400000);
+    constexpr int kBlock = 64; // about one serial read's worth of samples
+
+    for (bool coalesce : {true, false}) {
+        const QString name = QStringLiteral("DashModel onSignal");
+        if (!rep.wants(name)) break;
+        DashModel dash;
+        dash.setCoalesceUpdates(coalesce);
+        Run run(name, coalesce ? "coalesced" : "immediate", "sample");
+        for (int i = 0; i < batch.size(); i += kBlock) {
+            const int end = qMin(i + kBlock, int(batch.size()));
+            run.begin();
+            for (int k = i; k < end; ++k)
+                dash.onSignal(batch[k]);
+            if (coalesce) dash.flushPending(); // one frame per block
+            run.end(end - i);
+        }
+        rep.add(run.finish());
+    }
+
+    if (rep.wants("DashModel applySample")) {
+        DashModel dash;
+        dash.setCoalesceUpdates(false);
+        Run run("DashModel applySample", "immediate", "sample");
+        for (int i = 0; i + 8 <= batch.size(); i += 8 * kBlock) {
+            run.begin();
+            int n = 0;
+            for (int k = i; k + 8 <= qMin(i + 8 * kBlock, int(batch.size())); k += 8, ++n)
+                dash.applySample(batch[k].value, batch[k + 1].value, batch[k + 2].value, batch[k + 3].value,
+                                 batch[k + 4].value, batch[k + 5].value, batch[k + 6].value, int(batch[k + 7].value));
+            run.end(n);
+        }
+        rep.add(run.finish());
+    }
+}
+
+// Sampled-mode CSV logging row (same formatter main.cpp uses)
+void benchCsvRow(Reporter &rep) {
+    if (!rep.wants("CSV row")) return;
+    const SignalBatch batch = makeSignalBatch(88000);
+    constexpr int kBlock = 256;
+    QByteArray row;
+    row.reserve(200);
+    qint64 bytes = 0;
+
+    Run run("CSV row", QStringLiteral("block=%1").arg(kBlock), "row");
+    for (int i = 0; i + 11 <= batch.size(); i += 11 * kBlock) {
+        run.begin();
+        int n = 0;
+        for (int k = i; k + 11 <= qMin(i + 11 * kBlock, int(batch.size())); k += 11, ++n) {
+            row.clear(); // keeps capacity
+            appendCsvRow(row, batch[k].t_ms,
+                         {batch[k].value, batch[k + 1].value, 1.0, batch[k + 2].value, batch[k + 3].value,
+                          batch[k + 4].value, batch[k + 5].value, batch[k + 6].value, batch[k + 7].value,
+                          batch[k + 8].value, 101.3});
+            bytes += row.size();
+        }
+        run.end(n);
+    }
+    rep.add(run.finish());
+    rep.note(QStringLiteral("bytes formatted=%1").arg(bytes));
+}
+
+// Never-opened CAN transport: the benchmark emits canIn() itself.
+class BenchCanTransport : public ITransport {
+  public:
+    bool open() override { return true; }
+    void close() override {}
+    bool isOpen() const override { return true; }
+    Kind kind() const override { return Kind::Can; }
+};
+
+// All CAN frames of a capture, read through ReplayTransport at max speed.
+QVector<CanFrame> loadCanLog(const QString &path, QString *error) {
+    QVector<CanFrame> frames;
+    ReplayTransport replay(path, 0.0, false);
+    if (!replay.open()) {
+        *error = replay.errorString();
+        return frames;
+    }
+    QEventLoop loop;
+    QObject::connect(&replay, &ITransport::canIn, [&](quint32 id, const QByteArray &p, bool ext) { frames.append({id, p, ext}); });
+    QObject::connect(&replay, &ReplayTransport::finished, &loop, &QEventLoop::quit);
+    replay.beginInput();
+    loop.exec();
+    return frames;
+}
+
+// DBC decode of CAN frames: the compiled database alone, then the whole
+// protocol (decode + signal push + batch flush). A saturated 1 Mbit/s bus
+// carries about 8,700 8-byte 11-bit frames per second.
+void benchDbc(Reporter &rep, const QString &dbcPath, const QString &logPath) {
+    if (!rep.wants("DBC decode") && !rep.wants("DbcCanProtocol")) return;
+    constexpr double kSaturatedFps = 8700.0;
+
+    QTemporaryFile synthetic;
+    QString path = dbcPath;
+    if (path.isEmpty()) {
+        if (!synthetic.open()) return;
+        synthetic.write(makeBroadcastDbc());
+        synthetic.flush();
+        path = synthetic.fileName();
+    }
+    DbcDatabase db;
+    QFile f(path);
+    QString err;
+    if (!f.open(QIODevice::ReadOnly) || !db.load(&f, &err)) {
+        rep.note(QStringLiteral("cannot load DBC %1 %2").arg(path, err));
+        return;
+    }
+
+    QVector<CanFrame> frames;
+    if (logPath.isEmpty()) {
+        frames = makeCanTraffic(200000, 0.02);
+    } else {
+        frames = loadCanLog(logPath, &err);
+        if (frames.isEmpty()) {
+            rep.note(QStringLiteral("no CAN frames in %1 %2").arg(logPath, err));
+            return;
+        }
+    }
+    const QString source = logPath.isEmpty() ? QStringLiteral("synthetic") : QStringLiteral("recorded");
+    rep.note(QStringLiteral("DBC: %1 messages / %2 signals, %3 %4 frames")
+                 .arg(db.messageCount()).arg(db.signalCount()).arg(frames.size()).arg(source));
+
+    constexpr int kBlock = 1024;
+    volatile double sink = 0;
+    if (rep.wants("DBC decode")) {
+        Run run("DBC decode", source, "frame");
+        qint64 values = 0;
+        for (int i = 0; i < frames.size(); i += kBlock) {
+            const int end = qMin(i + kBlock, int(frames.size()));
+            run.begin();
+            double acc = 0;
+            for (int k = i; k < end; ++k) {
+                const CanFrame &fr = frames[k];
+                db.decode(fr.id, fr.extended, fr.payload.constData(), int(fr.payload.size()), [&](int, double v) { acc += v; ++values; });
+            }
+            run.end(end - i);
+            sink = sink + acc;
+        }
+        const Result r = run.finish();
+        rep.add(r);
+        rep.note(QStringLiteral("signal values=%1, %2x a saturated 1 Mbit/s bus")
+                     .arg(values).arg(r.itemsPerSec() / kSaturatedFps, 0, 'f', 0));
+    }
+
+    if (rep.wants("DbcCanProtocol")) {
+        BenchCanTransport can;
+        DbcCanProtocol proto(path);
+        if (!proto.probe(&can) || !proto.start(&can))
+            return;
+        qint64 samples = 0;
+        QObject::connect(&proto, &IECUProtocol::batch, [&](const SignalBatch &b) { samples += b.size(); });
+        Run run("DbcCanProtocol", source, "frame");
+        for (int i = 0; i < frames.size(); i += kBlock) {
+            const int end = qMin(i + kBlock, int(frames.size()));
+            run.begin();
+            for (int k = i; k < end; ++k)
+                emit can.canIn(frames[k].id, frames[k].payload, frames[k].extended);
+            QCoreApplication::processEvents(); // the flush timer: one batch per block
+            run.end(end - i);
+        }
+        const Result r = run.finish();
+        rep.add(r);
+        rep.note(QStringLiteral("samples emitted=%1, %2x a saturated 1 Mbit/s bus")
+                     .arg(samples).arg(r.itemsPerSec() / kSaturatedFps, 0, 'f', 0));
+    }
+}
+
+#ifdef Q_OS_LINUX
+int openCanSender(const QString &iface) {
+    const int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (s < 0) return -1;
+    sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = int(if_nametoindex(iface.toLocal8Bit().constData()));
+    if (!addr.can_ifindex || bind(s, reinterpret_cast<sockaddr *>(&addr), sizeof addr) < 0) {
+        ::close(s);
+        return -1;
+    }
+    return s;
+}
+
+// CAN receive on a live interface: bursts are written from a raw socket
+// (untimed), then the event loop is timed until the transport has delivered
+// the whole burst. QtSerialBus CanTransport (QCanBusFrame + QByteArray per
+// frame, canIn per frame) vs SocketCanTransport (recvmmsg batches, one
+// canFrames per batch).
+void benchCanReceive(Reporter &rep, const QString &iface) {
+    const bool qtBus = rep.wants("CAN receive QtSerialBus"), native = rep.wants("CAN receive SocketCAN");
+    if (iface.isEmpty() || !(qtBus || native)) return;
+    const int sender = openCanSender(iface);
+    if (sender < 0) {
+        rep.note(QStringLiteral("cannot open %1 for sending").arg(iface));
+        return;
+    }
+    const QVector<CanFrame> traffic = makeCanTraffic(100000, 0.0);
+    constexpr int kBurst = 128; // stays inside the default socket receive buffer
+
+    auto timeReceive = [&](const QString &name, ITransport &t, const qint64 &received) {
+        Run run(name, iface, "frame");
+        qint64 lost = 0;
+        for (int i = 0; i < traffic.size(); i += kBurst) {
+            const int end = qMin(i + kBurst, int(traffic.size()));
+            for (int k = i; k < end; ++k) {
+                can_frame f{};
+                const quint32 id = traffic[k].id;
+                f.can_id = traffic[k].extended ? (id | CAN_EFF_FLAG) : id;
+                f.can_dlc = quint8(qMin(int(traffic[k].payload.size()), CAN_MAX_DLEN));
+                std::memcpy(f.data, traffic[k].payload.constData(), f.can_dlc);
+                if (::write(sender, &f, sizeof f) != qint64(sizeof f)) ++lost;
+            }
+            const qint64 before = received, target = before + (end - i);
+            QElapsedTimer guard;
+            guard.start();
+            run.begin();
+            while (received < target && guard.elapsed() < 1000)
+                QCoreApplication::processEvents();
+            run.end(received - before);
+            lost += target - received;
+        }
+        t.close();
+        rep.add(run.finish());
+        if (lost) rep.note(QStringLiteral("%1: %2 frames not delivered").arg(name).arg(lost));
+    };
+
+    if (qtBus) {
+        CanTransport can(iface, QStringLiteral("socketcan"));
+        qint64 received = 0;
+        QObject::connect(&can, &ITransport::canIn, [&](quint32, const QByteArray &) { ++received; });
+        if (can.open()) timeReceive("CAN receive QtSerialBus", can, received);
+        else rep.note(QStringLiteral("QtSerialBus cannot open %1").arg(iface));
+    }
+    if (native) {
+        SocketCanTransport can({iface});
+        qint64 received = 0;
+        QObject::connect(&can, &ITransport::canFrames, [&](const RawCanFrame *, int n) { received += n; });
+        if (can.open()) timeReceive("CAN receive SocketCAN", can, received);
+        else rep.note(QStringLiteral("SocketCAN cannot open %1: %2").arg(iface, can.errorString()));
+    }
+    ::close(sender);
+}
+#else
+void benchCanReceive(Reporter &rep, const QString &iface) {
+    if (!iface.isEmpty()) rep.note("CAN receive: Linux only");
+}
+#endif
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser cli;
+    cli.setApplicationDescription("KeyDash micro-benchmarks");
+    cli.addHelpOption();
+    const QCommandLineOption filterOpt("filter", "Only run benchmarks whose name contains <text>.", "text");
+    const QCommandLineOption jsonOpt("json", "Write results as JSON to <file>.", "file");
+    const QCommandLineOption csvOpt("csv", "Write results as CSV to <file>.", "file");
+    const QCommandLineOption labelOpt("label", "Tag stored with the results (e.g. a commit hash).", "text");
+    const QCommandLineOption dbcOpt("dbc", "DBC file for the CAN benchmarks.", "file");
+    const QCommandLineOption canLogOpt("can-log", "CAN traffic (candump -l log or .kdcap) for the CAN benchmarks.", "file");
+    const QCommandLineOption vcanOpt("vcan", "Time CAN receive on live interface <iface> (e.g. vcan0).", "iface");
+    cli.addOptions({filterOpt, jsonOpt, csvOpt, labelOpt, dbcOpt, canLogOpt, vcanOpt});
+    cli.process(app);
+
+    Reporter rep(cli.value(filterOpt));
+    if (!countsMalloc())
+        rep.note("note: allocation counts only include operator new on this platform");
+
+    benchClassicDecoder(rep);
+    benchClassicChannelPath(rep);
+    benchDecodeScale(rep);
+    benchElmParseLine(rep);
+    benchDashModel(rep);
+    benchCsvRow(rep);
+    benchDbc(rep, cli.value(dbcOpt), cli.value(canLogOpt));
+    benchCanReceive(rep, cli.value(vcanOpt));
+
+    bool ok = true;
+    if (cli.isSet(jsonOpt)) ok = rep.writeJson(cli.value(jsonOpt), cli.value(labelOpt)) && ok;
+    if (cli.isSet(csvOpt))  ok = rep.writeCsv(cli.value(csvOpt), cli.value(labelOpt)) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include "generators.h"
+
+#include <QRandomGenerator>
+
+namespace Bench {
+
+QByteArray makeClassicStream(int frames, double garbageRatio, quint32 seed) {
+    QRandomGenerator rng(seed);
+    QByteArray out;
+    out.reserve(frames * 6);
+    for (int i = 0; i < frames; ++i) {
+        const quint8 ch = quint8(1 + (i % 32));
+        const quint8 vh = quint8(rng.bounded(256));
+        const quint8 vl = quint8(rng.bounded(256));
+        const quint8 cs = quint8((ch + 0xA3 + vh + vl) & 0xFF);
+        out.append(char(ch)).append(char(0xA3)).append(char(vh)).append(char(vl)).append(char(cs));
+        if (rng.generateDouble() < garbageRatio)
+            out.append(char(rng.bounded(256)));
+    }
+    return out;
+}
+
+namespace {
+QByteArray hexByte(quint32 v) {
+    return QByteArray::number(v & 0xFF, 16).rightJustified(2, '0').toUpper();
+}
+
+// "41 <pid> <data...>" for one PID, data width per SAE J1979
+QByteArray pidAnswer(quint8 pid, QRandomGenerator &rng, bool spaced) {
+    const int bytes = (pid == 0x0C) ? 2 : 1;
+    QList<QByteArray> parts{hexByte(0x41), hexByte(pid)};
+    for (int b = 0; b < bytes; ++b)
+        parts << hexByte(rng.bounded(256));
+    return parts.join(spaced ? " " : "");
+}
+}
+
+QVector<QByteArray> makeElmResponses(int lines, quint32 seed) {
+    static const quint8 kPids[] = {0x0C, 0x0D, 0x0B, 0x11, 0x05, 0x0F};
+    QRandomGenerator rng(seed);
+    QVector<QByteArray> out;
+    out.reserve(lines);
+    for (int i = 0; i < lines; ++i) {
+        const quint8 pid = kPids[rng.bounded(int(sizeof(kPids)))];
+        const int kind = rng.bounded(100);
+        if (kind < 60) {
+            out.append(pidAnswer(pid, rng, true));
+        } else if (kind < 75) {
+            out.append(pidAnswer(pid, rng, false));
+        } else if (kind < 92) {
+            // packed request answer: 41 + (pid data) x 3
+            QByteArray l = pidAnswer(0x0C, rng, true);
+            l += pidAnswer(0x0D, rng, true).mid(2);
+            l += pidAnswer(0x11, rng, true).mid(2);
+            out.append(l);
+        } else if (kind < 96) {
+            out.append("7E8 03 " + pidAnswer(pid, rng, true)); // headers on (ATH1): rejected
+        } else if (kind < 98) {
+            out.append("SEARCHING...");
+        } else {
+            out.append("NO DATA");
+        }
+    }
+    return out;
+}
+
+SignalBatch makeSignalBatch(int samples, quint32 seed) {
+    static const SignalId kIds[] = {
+        Sig::EngineRpm, Sig::VehicleSpeedKph, Sig::EngineMapKpa, Sig::TempsCltC,
+        Sig::TempsIatC, Sig::ElectricalVbat, Sig::LambdaAfr, Sig::DrivetrainGear,
+    };
+    QRandomGenerator rng(seed);
+    SignalBatch out;
+    out.reserve(samples);
+    qint64 t = 1700000000000;
+    double rpm = 900.0;
+    for (int i = 0; i < samples; ++i) {
+        const SignalId id = kIds[i % int(sizeof(kIds) / sizeof(kIds[0]))];
+        double v = 0.0;
+        switch (id) {
+        case Sig::EngineRpm:
+            rpm = qBound(700.0, rpm + rng.bounded(200.0) - 100.0, 7500.0);
+            v = rpm;
+            break;
+        case Sig::VehicleSpeedKph: v = rng.bounded(180.0); break;
+        case Sig::EngineMapKpa:    v = 30.0 + rng.bounded(170.0); break;
+        case Sig::TempsCltC:       v = 80.0 + rng.bounded(20.0); break;
+        case Sig::TempsIatC:       v = 20.0 + rng.bounded(40.0); break;
+        case Sig::ElectricalVbat:  v = 13.0 + rng.bounded(1.5); break;
+        case Sig::LambdaAfr:       v = 11.0 + rng.bounded(5.0); break;
+        default:                   v = 1 + rng.bounded(5); break;
+        }
+        out.append({id, v, t});
+        t += 2;
+    }
+    return out;
+}
+
+namespace {
+constexpr int     kStdMessages = 24;
+constexpr quint32 kStdBase     = 0x360;
+constexpr quint32 kMuxId       = 0x3E0;
+constexpr quint32 kExtBase     = 0x18FF0000;
+constexpr int     kExtMessages = 4;
+}
+
+QByteArray makeBroadcastDbc() {
+    QByteArray dbc = "VERSION \"\"\n\nBU_: ECU\n\n";
+    for (int m = 0; m < kStdMessages; ++m) {
+        dbc += "BO_ " + QByteArray::number(kStdBase + m) + " Msg" + QByteArray::number(m) + ": 8 ECU\n";
+        for (int s = 0; s < 4; ++s) {
+            const char sign = (s == 3) ? '-' : '+';
+            dbc += " SG_ S" + QByteArray::number(m) + "_" + QByteArray::number(s) + " : " +
+                   QByteArray::number(s * 16 + 7) + "|16@0" + sign + " (0.1,-40) [0|0] \"\" Vector__XXX\n";
+        }
+        dbc += "\n";
+    }
+    dbc += "BO_ " + QByteArray::number(kMuxId) + " MuxMsg: 8 ECU\n";
+    dbc += " SG_ Page M : 0|8@1+ (1,0) [0|3] \"\" Vector__XXX\n";
+    for (int page = 0; page < 4; ++page)
+        for (int s = 0; s < 3; ++s)
+            dbc += " SG_ P" + QByteArray::number(page) + "_" + QByteArray::number(s) + " m" +
+                   QByteArray::number(page) + " : " + QByteArray::number(8 + s * 16) +
+                   "|16@1+ (0.01,0) [0|0] \"\" Vector__XXX\n";
+    dbc += "\n";
+    for (int m = 0; m < kExtMessages; ++m) {
+        dbc += "BO_ " + QByteArray::number(0x80000000u | (kExtBase + m)) + " Ext" + QByteArray::number(m) + ": 8 ECU\n";
+        dbc += " SG_ E" + QByteArray::number(m) + "_a : 0|32@1- (0.001,0) [0|0] \"\" Vector__XXX\n";
+        dbc += " SG_ E" + QByteArray::number(m) + "_b : 32|12@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+        dbc += " SG_ E" + QByteArray::number(m) + "_c : 44|20@1- (0.5,0) [0|0] \"\" Vector__XXX\n";
+        dbc += "\n";
+    }
+    return dbc;
+}
+
+QVector<CanFrame> makeCanTraffic(int frames, double unknownRatio, quint32 seed) {
+    QRandomGenerator rng(seed);
+    QVector<quint32> ids;
+    for (int m = 0; m < kStdMessages; ++m) ids << kStdBase + m;
+    ids << kMuxId;
+    for (int m = 0; m < kExtMessages; ++m) ids << kExtBase + m;
+
+    QVector<CanFrame> out;
+    out.reserve(frames);
+    for (int i = 0; i < frames; ++i) {
+        quint32 id = ids[i % ids.size()];
+        if (rng.generateDouble() < unknownRatio)
+            id = 0x100 + quint32(rng.bounded(0x100)); // not in the DBC
+        QByteArray payload(8, Qt::Uninitialized);
+        for (int b = 0; b < 8; ++b)
+            payload[b] = char(rng.bounded(256));
+        if (id == kMuxId)
+            payload[0] = char(rng.bounded(4)); // valid page
+        out.append({id, payload, id > 0x7FF}); // the DBC's extended ids are all above 0x7FF
+    }
+    return out;
+}
+
+} // namespace Bench
@@ -0,0 +1,37 @@
+#pragma once
+#include <QByteArray>
+#include <QVector>
+#include "core/signal_types.h"
+
+// Deterministic synthetic inputs for keydash_bench (fixed seeds, so runs
+// on different commits see identical data).
+namespace Bench {
+
+// ECUMaster classic stream: [ch][0xA3][hi][lo][cs] frames over channels
+// 1..32, with a stray byte inserted after `garbageRatio` of the frames.
+QByteArray makeClassicStream(int frames, double garbageRatio, quint32 seed = 1234);
+
+// ELM327 mode 01 answers as they arrive between '>' prompts: mostly
+// spaced single-PID lines, plus unspaced, multi-PID (packed request),
+// "SEARCHING..." / "NO DATA" noise and multi-ECU duplicates.
+QVector<QByteArray> makeElmResponses(int lines, quint32 seed = 4321);
+
+// Normalized samples for the well-known dash signals, time-ordered.
+SignalBatch makeSignalBatch(int samples, quint32 seed = 99);
+
+// ECU broadcast DBC in the style of Haltech/Link streams: 24 standard-id
+// messages with four 16-bit Motorola signals each (some signed), one
+// multiplexed message and 4 extended-id messages with Intel signals.
+QByteArray makeBroadcastDbc();
+
+struct CanFrame {
+    quint32    id;
+    QByteArray payload;
+    bool       extended = false;
+};
+
+// 8-byte frames cycling through makeBroadcastDbc()'s ids, random payloads,
+// with `unknownRatio` of the frames on ids the DBC does not define.
+QVector<CanFrame> makeCanTraffic(int frames, double unknownRatio, quint32 seed = 777);
+
+} // namespace Bench
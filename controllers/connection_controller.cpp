@@ -1,20 +1,59 @@
 #include "controllers/connection_controller.h"
 #include "transports/serial_transport.h"
 #include "transports/can_transport.h"
+#include "transports/capture_recorder.h"
+#include "transports/replay_transport.h"
+#include "transports/socketcan_transport.h"
 #include "protocols/obd2_elm327.h"
 #include "protocols/ecumaster_classic.h"
+#include "protocols/dbc_can_protocol.h"
 #include <QSerialPortInfo>
+#include <QUrl>
 #include "protocols/demo_protocol.h"
 
 ConnectionController::ConnectionController(QObject *parent) : QObject(parent) {
-    m_mgr = new EcuManager(this);
-    connect(m_mgr, &EcuManager::sig, this, &ConnectionController::sig);
+    m_io.setObjectName(QStringLiteral("KeyDash I/O"));
+    m_mgr = new EcuManager; // no parent: moved to the I/O thread
+    m_mgr->moveToThread(&m_io);
+    connect(m_mgr, &EcuManager::samplesReady, this, &ConnectionController::drainSamples, Qt::QueuedConnection);
     connect(m_mgr, &EcuManager::statusChanged, this, &ConnectionController::statusChanged);
+    m_drainBuf.reserve(EcuManager::kQueueCapacity);
+    m_io.start(QThread::HighPriority);
 }
 
-ConnectionController::~ConnectionController() { if (m_mgr) m_mgr->stop(); }
+ConnectionController::~ConnectionController() {
+    runOnIo([this] { m_mgr->shutdown(); return true; });
+    m_io.quit();
+    m_io.wait();
+    delete m_mgr;
+}
+
+void ConnectionController::drainSamples() {
+    m_drainBuf.clear();
+    if (m_mgr->drain(m_drainBuf) > 0)
+        emit batch(m_drainBuf); // DashModel applies synchronously
+
+    m_traceBuf.clear();
+    m_mgr->drainTrace(m_traceBuf);
+    const qint64 now = LatencyTracer::nowUs();
+    for (LatencyTracer::Token &t : m_traceBuf) {
+        t.applyUs = now;
+        m_latency.applied(t);
+    }
+}
+
+QVariantMap ConnectionController::acquisitionStats() const {
+    QVariantMap m;
+    m.insert("queueCapacity", EcuManager::kQueueCapacity);
+    m.insert("queueDepth", m_mgr->queueDepth());
+    m.insert("queueHighWater", m_mgr->queueHighWater());
+    m.insert("dropped", m_mgr->dropped());
+    return m;
+}
 
-bool ConnectionController::setupTransport(const QString &key, const QString &port, int baud, const QString &canIf) {
+ITransport *ConnectionController::setupTransport(const QString &key, const QString &port, int baud, const QString &canIf) {
+    ITransport *t = nullptr;
+    QString desc;
     if (key == "serial") {
         QString p = port.trimmed();
         if (p.isEmpty()) {
@@ -24,43 +63,93 @@ bool ConnectionController::setupTransport(const QString &key, const QString &por
         }
         if (p.isEmpty()) {
             emit statusChanged("Transport failed: no serial port specified (and none detected)");
-            return false;
+            return nullptr;
         }
-        m_transport.reset(new SerialTransport(p, baud, this));
-        if (!m_transport->open()) {
+        t = new SerialTransport(p, baud);
+        desc = QString("Serial open: %1 @ %2").arg(p).arg(baud);
+        t->moveToThread(&m_io);
+        if (!runOnIo([t] { return t->open(); })) {
+            t->deleteLater();
             emit statusChanged(QString("Transport failed: cannot open %1 @ %2 baud").arg(p).arg(baud));
-            return false;
+            return nullptr;
         }
-        emit statusChanged(QString("Serial open: %1 @ %2").arg(p).arg(baud));
-        return true;
 
     } else if (key == "can") {
         QString ifc = canIf.trimmed().isEmpty() ? QStringLiteral("can0") : canIf.trimmed();
-        m_transport.reset(new CanTransport(ifc, "socketcan", this));
-        if (!m_transport->open()) {
+        t = new CanTransport(ifc, "socketcan");
+        if (m_capture) m_capture->setInterfaceName(ifc);
+        desc = QString("CAN open: %1").arg(ifc);
+        t->moveToThread(&m_io);
+        if (!runOnIo([t] { return t->open(); })) {
+            t->deleteLater();
             emit statusChanged(QString("Transport failed: cannot open CAN iface %1").arg(ifc));
-            return false;
+            return nullptr;
         }
-        emit statusChanged(QString("CAN open: %1").arg(ifc));
-        return true;
+
+    } else if (key == "socketcan") {
+        // Native SocketCAN; several interfaces as "can0,can1"
+        QStringList ifaces;
+        for (const QString &i : canIf.split(',', Qt::SkipEmptyParts))
+            if (!i.trimmed().isEmpty()) ifaces << i.trimmed();
+        if (ifaces.isEmpty())
+            ifaces << QStringLiteral("can0");
+        auto *st = new SocketCanTransport(ifaces);
+        st->moveToThread(&m_io);
+        if (!runOnIo([st] { return st->open(); })) {
+            emit statusChanged(QString("Transport failed: cannot open SocketCAN %1: %2").arg(ifaces.join(','), st->errorString()));
+            st->deleteLater();
+            return nullptr;
+        }
+        if (m_capture) m_capture->setInterfaceName(ifaces.first());
+        desc = QString("SocketCAN open: %1").arg(ifaces.join(", "));
+        t = st;
+
+    } else if (key == "replay") {
+        const QString path = port.trimmed();
+        if (path.isEmpty()) {
+            emit statusChanged("Transport failed: no capture file specified");
+            return nullptr;
+        }
+        auto *rt = new ReplayTransport(path, m_replaySpeed, m_replayLoop);
+        rt->moveToThread(&m_io);
+        if (!runOnIo([rt] { return rt->open(); })) {
+            emit statusChanged(QString("Transport failed: cannot replay %1: %2").arg(path, rt->errorString()));
+            rt->deleteLater();
+            return nullptr;
+        }
+        connect(rt, &ReplayTransport::finished, this, [this] { emit statusChanged("Replay finished"); });
+        desc = QString("Replay: %1 (%2 events, %3 s) @ %4")
+                   .arg(path)
+                   .arg(rt->eventCount())
+                   .arg(rt->durationUs() / 1e6, 0, 'f', 1)
+                   .arg(m_replaySpeed > 0.0 ? QString("%1x").arg(m_replaySpeed) : QString("max speed"));
+        t = rt;
+
+    } else {
+        emit statusChanged("Transport failed: unknown transport key");
+        return nullptr;
     }
-    emit statusChanged("Transport failed: unknown transport key");
-    return false;
+    emit statusChanged(desc);
+    return t;
 }
 
-bool ConnectionController::setupProtocol(const QString &key) {
+IECUProtocol *ConnectionController::setupProtocol(const QString &key) {
+    IECUProtocol *p = nullptr;
     if (key == "OBD2") {
-        m_protocol.reset(new OBD2Elm327Protocol(this));
-        return true;
+        p = new OBD2Elm327Protocol;
     } else if (key == "ECUMasterClassic") {
-        m_protocol.reset(new EcuMasterClassicProtocol(this));
-        return true;
+        p = new EcuMasterClassicProtocol;
+    } else if (key == "DBC") {
+        QString path = m_dbcPath.trimmed();
+        if (path.startsWith("file:"))
+            path = QUrl(path).toLocalFile();
+        p = new DbcCanProtocol(path);
     } else if (key == "Demo") {
-        m_protocol.reset(new DemoProtocol(this));
-        return true;
+        p = new DemoProtocol;
     }
-
-    return false;
+    if (p)
+        p->moveToThread(&m_io);
+    return p;
 }
 
 bool ConnectionController::apply(const QString &transportKey,
@@ -68,18 +157,24 @@ bool ConnectionController::apply(const QString &transportKey,
                                  const QString &canIface,
                                  const QString &protoKey)
 {
+    // 0) Tear down the previous session on the I/O thread
+    runOnIo([this] { m_mgr->shutdown(); return true; });
+
     // 1) Set up protocol first so we can special-case Demo
-    if (!setupProtocol(protoKey)) {
+    IECUProtocol *proto = setupProtocol(protoKey);
+    if (!proto) {
         emit statusChanged(QString("Unknown protocol: %1").arg(protoKey));
         return false;
     }
 
            // 2) Demo protocol requires NO hardware/transport
     if (protoKey == "Demo") {
-        m_transport.reset(nullptr);
-        m_mgr->setTransport(nullptr);
-        m_mgr->setProtocol(m_protocol.take()); // manager owns protocol
-        if (!m_mgr->start()) {
+        const bool ok = runOnIo([this, proto] {
+            m_mgr->setTransport(nullptr);
+            m_mgr->setProtocol(proto); // manager owns protocol
+            return m_mgr->start();
+        });
+        if (!ok) {
             emit statusChanged("Failed to start Demo protocol");
             return false;
         }
@@ -88,16 +183,31 @@ bool ConnectionController::apply(const QString &transportKey,
     }
 
            // 3) All other protocols: open the requested transport
-    if (!setupTransport(transportKey, portName, baud, canIface)) {
+    ITransport *transport = setupTransport(transportKey, portName, baud, canIface);
+    if (!transport) {
+        proto->deleteLater();
         emit statusChanged(QString("Transport failed: %1 (port='%2', baud=%3, iface='%4')")
                                .arg(transportKey, portName, QString::number(baud), canIface));
         return false;
     }
 
-           // 4) Wire up and start
-    m_mgr->setTransport(m_transport.data());
-    m_mgr->setProtocol(m_protocol.take()); // manager owns protocol
-    if (!m_mgr->start()) {
+           // 4) Wire up and start. The capture tap is connected first, so it
+           //    sees each chunk before the protocol consumes it.
+    if (m_capture) {
+        CaptureRecorder *cap = m_capture;
+        connect(transport, &ITransport::bytesIn, transport,
+                [cap](const QByteArray &b) { cap->recordBytes(b.constData(), b.size()); });
+        connect(transport, &ITransport::canIn, transport,
+                [cap](quint32 id, const QByteArray &payload, bool extended) { cap->recordCan(id, payload, extended); });
+        connect(transport, &ITransport::canFrames, transport,
+                [cap](const RawCanFrame *frames, int count) { cap->recordCanFrames(frames, count); });
+    }
+    const bool ok = runOnIo([this, transport, proto] {
+        m_mgr->setTransport(transport); // manager owns transport
+        m_mgr->setProtocol(proto);      // manager owns protocol
+        return m_mgr->start();
+    });
+    if (!ok) {
         emit statusChanged("Failed to start ECU protocol");
         return false;
     }
@@ -105,4 +215,3 @@ bool ConnectionController::apply(const QString &transportKey,
     emit statusChanged(QString("Connected via %1 / %2").arg(transportKey, protoKey));
     return true;
 }
-
@@ -1,33 +1,80 @@
 #pragma once
 #include <QObject>
-#include <QPointer>
+#include <QThread>
+#include <QVariantMap>
 #include "core/ecu_manager.h"
+#include "core/latency_tracer.h"
 #include "core/signal_types.h"
 
+class CaptureRecorder;
 class ITransport;
 class IECUProtocol;
 
+// GUI-side façade for the acquisition pipeline. Transports and protocols
+// are created here but live on a dedicated I/O thread (owned by EcuManager),
+// so serial/CAN reads and decoding are independent of QML rendering load.
 class ConnectionController : public QObject {
     Q_OBJECT
+           // Pacing for the "replay" transport: 1 = real time, N = N×, 0 = as fast as possible
+    Q_PROPERTY(double replaySpeed READ replaySpeed WRITE setReplaySpeed NOTIFY replayOptionsChanged)
+    Q_PROPERTY(bool replayLoop READ replayLoop WRITE setReplayLoop NOTIFY replayOptionsChanged)
+           // DBC file for the "DBC" protocol (CAN transports)
+    Q_PROPERTY(QString dbcPath READ dbcPath WRITE setDbcPath NOTIFY dbcPathChanged)
   public:
     explicit ConnectionController(QObject *parent=nullptr);
     ~ConnectionController();
 
-           // QML calls this when you press “Apply & Connect”
+           // QML calls this when you press “Apply & Connect”.
+           // transportKey "replay": portName is the capture file path.
+           // transportKey "socketcan": canIface may list several ("can0,can1").
     Q_INVOKABLE bool apply(const QString &transportKey,
                            const QString &portName, int baud,
                            const QString &canIface,
                            const QString &protoKey);
 
+           // queueDepth / queueHighWater / dropped for the I/O → GUI hand-off
+    Q_INVOKABLE QVariantMap acquisitionStats() const;
+
+           // Per-batch transport → screen latency (window attached in main)
+    LatencyTracer *latency() { return &m_latency; }
+
+           // Raw capture tap on every transport opened from now on (not owned)
+    void setCaptureRecorder(CaptureRecorder *r) { m_capture = r; }
+
+    double replaySpeed() const { return m_replaySpeed; }
+    void setReplaySpeed(double s) { s = qMax(0.0, s); if (s != m_replaySpeed) { m_replaySpeed = s; emit replayOptionsChanged(); } }
+    bool replayLoop() const { return m_replayLoop; }
+    void setReplayLoop(bool on) { if (on != m_replayLoop) { m_replayLoop = on; emit replayOptionsChanged(); } }
+    QString dbcPath() const { return m_dbcPath; }
+    void setDbcPath(const QString &p) { if (p != m_dbcPath) { m_dbcPath = p; emit dbcPathChanged(); } }
+
   signals:
-    void sig(const SignalUpdate &update);
+    void batch(const SignalBatch &updates);
     void statusChanged(const QString &status);
+    void replayOptionsChanged();
+    void dbcPathChanged();
+
+  private slots:
+    void drainSamples();
 
   private:
-    QPointer<EcuManager> m_mgr;
-    QScopedPointer<ITransport> m_transport;
-    QScopedPointer<IECUProtocol> m_protocol;
+    QThread m_io;
+    EcuManager *m_mgr{nullptr};  // lives on m_io
+    SignalBatch m_drainBuf;      // reused between drains
+    LatencyTracer m_latency;
+    CaptureRecorder *m_capture{nullptr};
+    double m_replaySpeed{1.0};
+    bool m_replayLoop{false};
+    QString m_dbcPath;
+    QVector<LatencyTracer::Token> m_traceBuf;
+
+    ITransport *setupTransport(const QString &transportKey, const QString &portName, int baud, const QString &canIface);
+    IECUProtocol *setupProtocol(const QString &protoKey);
 
-    bool setupTransport(const QString &transportKey, const QString &portName, int baud, const QString &canIface);
-    bool setupProtocol(const QString &protoKey);
+           // Run fn on the I/O thread and wait for its bool result.
+    template <typename Fn> bool runOnIo(Fn &&fn) {
+        bool ok = false;
+        QMetaObject::invokeMethod(m_mgr, std::forward<Fn>(fn), Qt::BlockingQueuedConnection, &ok);
+        return ok;
+    }
 };
@@ -1,23 +1,106 @@
 #include "ecu_manager.h"
-#include "core/itransport.h"
 
 EcuManager::EcuManager(QObject *parent) : QObject(parent) {}
-EcuManager::~EcuManager() { stop(); }
+EcuManager::~EcuManager() { shutdown(); }
+
+void EcuManager::setTransport(ITransport *t) {
+    if (m_t.data() == t) return;
+    m_t.reset(t);
+    m_arrivalUs = 0;
+    if (m_t) {
+        // Connected before the protocol's own slots (setProtocol/start run
+        // later), so the arrival stamp is taken ahead of decoding.
+        connect(m_t.data(), &ITransport::bytesIn, this, &EcuManager::onTransportInput);
+        connect(m_t.data(), &ITransport::canIn, this, &EcuManager::onTransportInput);
+        connect(m_t.data(), &ITransport::canFrames, this, &EcuManager::onTransportInput);
+    }
+}
+
+void EcuManager::onTransportInput() {
+    if (!m_arrivalUs)
+        m_arrivalUs = LatencyTracer::nowUs();
+}
 
-void EcuManager::setTransport(ITransport *t) { m_t = t; }
 void EcuManager::setProtocol(IECUProtocol *p) {
     if (m_p) { m_p->stop(); m_p.reset(); }
     m_p.reset(p);
     if (m_p) {
-        connect(m_p.data(), &IECUProtocol::sig, this, &EcuManager::sig);
+        connect(m_p.data(), &IECUProtocol::batch, this, &EcuManager::onProtocolBatch);
         connect(m_p.data(), &IECUProtocol::statusChanged, this, &EcuManager::statusChanged);
+        connect(m_p.data(), &IECUProtocol::canIdsChanged, this, &EcuManager::applyCanIds);
     }
 }
 
 bool EcuManager::start() {
     if (!m_p) return false;
-    if (!m_p->probe(m_t)) return false;
-    return m_p->start(m_t);
+    if (!m_p->probe(m_t.data())) return false;
+    if (!m_p->start(m_t.data())) return false;
+    applyCanIds(); // decode set is known once the protocol has started
+    if (m_t) m_t->beginInput();
+    return true;
+}
+
+void EcuManager::applyCanIds() {
+    if (m_t && m_p) m_t->setCanIds(m_p->canIds());
 }
 
 void EcuManager::stop() { if (m_p) m_p->stop(); }
+
+void EcuManager::shutdown() {
+    setProtocol(nullptr);
+    if (m_t) m_t->close();
+    m_t.reset();
+}
+
+void EcuManager::onProtocolBatch(const SignalBatch &updates) {
+    LatencyTracer::Token tok;
+    tok.decodeUs = LatencyTracer::nowUs();
+    tok.arrivalUs = m_arrivalUs ? m_arrivalUs : tok.decodeUs; // timer-driven (Demo): no input
+    m_arrivalUs = 0;
+
+    const quint64 before = m_pushed;
+    for (const SignalUpdate &up : updates) {
+        if (m_ring.push(up))
+            ++m_pushed;
+        else
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_mSignals->add(m_pushed - before);
+    m_mDropped->add(quint64(updates.size()) - (m_pushed - before));
+    tok.endSeq = m_pushed;
+    m_trace.push(tok); // full: this batch just goes untraced
+
+    const quint32 depth = m_ring.size();
+    m_mDepth->set(depth);
+    if (depth > m_highWater.load(std::memory_order_relaxed))
+        m_highWater.store(depth, std::memory_order_relaxed);
+
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel))
+        emit samplesReady();
+}
+
+int EcuManager::drain(SignalBatch &out) {
+    // Clear the flag before popping so a push racing with us re-notifies.
+    m_notifyPending.store(false, std::memory_order_release);
+    const quint32 avail = m_ring.size();
+    if (!avail) return 0;
+    const qsizetype base = out.size();
+    out.resize(base + avail);
+    const quint32 got = m_ring.pop(out.data() + base, avail);
+    out.resize(base + got);
+    m_popped += got;
+    return int(got);
+}
+
+void EcuManager::drainTrace(QVector<LatencyTracer::Token> &out) {
+    LatencyTracer::Token buf[kTraceCapacity];
+    const quint32 n = m_trace.pop(buf, kTraceCapacity);
+    for (quint32 i = 0; i < n; ++i)
+        m_traceWait.append(buf[i]);
+
+    // Tokens are FIFO; release those whose samples were all drained.
+    int done = 0;
+    while (done < m_traceWait.size() && m_traceWait[done].endSeq <= m_popped)
+        out.append(m_traceWait[done++]);
+    m_traceWait.remove(0, done);
+}
@@ -1,27 +1,71 @@
 #pragma once
 #include <QObject>
 #include <QScopedPointer>
+#include <atomic>
 #include "core/iecuprotocol.h"
+#include "core/itransport.h"
+#include "core/latency_tracer.h"
+#include "core/pipeline_metrics.h"
+#include "core/spsc_ring.h"
 
-class ITransport;
-
+// Runs on the acquisition (I/O) thread: owns the active transport and
+// protocol, and hands decoded samples to the GUI thread through a lock-free
+// SPSC ring. The consumer is notified with samplesReady() (at most one
+// notification in flight) and pulls everything with drain().
 class EcuManager : public QObject {
     Q_OBJECT
   public:
+    static constexpr quint32 kQueueCapacity = 4096;
+    static constexpr quint32 kTraceCapacity = 256;
+
     explicit EcuManager(QObject *parent=nullptr);
     ~EcuManager();
 
-           // Ownership stays here; you can expose setters for UI
-    void setTransport(ITransport *t);   // injected from app
-    void setProtocol(IECUProtocol *p);  // pick specific
+           // I/O thread. Both take ownership.
+    void setTransport(ITransport *t);
+    void setProtocol(IECUProtocol *p);
     bool start();
     void stop();
+    void shutdown(); // stop and release protocol + transport
+
+           // Consumer (GUI) thread. Appends all queued samples to `out`.
+    int drain(SignalBatch &out);
+           // Consumer thread, after drain(): trace tokens of batches whose
+           // samples have all been drained so far (appended to `out`).
+    void drainTrace(QVector<LatencyTracer::Token> &out);
+
+    quint64 dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    quint32 queueDepth() const { return m_ring.size(); }
+    quint32 queueHighWater() const { return m_highWater.load(std::memory_order_relaxed); }
 
   signals:
-    void sig(const SignalUpdate &update);
+    void samplesReady();
     void statusChanged(const QString&);
 
+  private slots:
+    void onProtocolBatch(const SignalBatch &updates);
+    void applyCanIds(); // protocol decode set -> transport filters
+
   private:
-    ITransport *m_t{nullptr};
+    void onTransportInput();
+
+    QScopedPointer<ITransport> m_t;
     QScopedPointer<IECUProtocol> m_p;
+
+    SpscRing<SignalUpdate, kQueueCapacity> m_ring;
+    std::atomic<bool> m_notifyPending{false};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint32> m_highWater{0};
+
+    // Latency trace (see LatencyTracer). m_pushed/m_arrivalUs: I/O thread;
+    // m_popped/m_traceWait: consumer thread.
+    PipelineMetrics::Counter *m_mSignals = PipelineMetrics::instance().counter("pipeline.signals");
+    PipelineMetrics::Counter *m_mDropped = PipelineMetrics::instance().counter("pipeline.dropped");
+    PipelineMetrics::Gauge   *m_mDepth   = PipelineMetrics::instance().gauge("pipeline.queueDepth");
+
+    SpscRing<LatencyTracer::Token, kTraceCapacity> m_trace;
+    quint64 m_pushed{0};
+    qint64 m_arrivalUs{0};   // first transport input since the last batch
+    quint64 m_popped{0};
+    QVector<LatencyTracer::Token> m_traceWait;
 };
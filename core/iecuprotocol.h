@@ -1,9 +1,8 @@
 #pragma once
 #include <QObject>
+#include "itransport.h"
 #include "signal_types.h"
 
-class ITransport;
-
 class IECUProtocol : public QObject {
     Q_OBJECT
   public:
@@ -18,7 +17,25 @@ class IECUProtocol : public QObject {
     virtual void stop() = 0;
     virtual QString name() const = 0;
 
+           // CAN ids this protocol decodes, for transport-side filtering.
+           // Empty = needs every frame (or not a CAN protocol).
+    virtual QVector<CanId> canIds() const { return {}; }
+
   signals:
-    void sig(const SignalUpdate &update); // normalized signals to data model
+    void batch(const SignalBatch &updates); // normalized signals to data model
     void statusChanged(const QString &status);
+    void canIdsChanged(); // canIds() differs from the last call
+
+  protected:
+    // Queue one sample; flush() emits everything queued as one batch.
+    // Call flush() once per transport read / timer tick.
+    void push(SignalId id, double value, qint64 t_ms) { m_pending.append({id, value, t_ms}); }
+    void flush() {
+        if (m_pending.isEmpty()) return;
+        emit batch(m_pending);
+        m_pending.clear(); // keeps capacity unless a receiver still shares it
+    }
+
+  private:
+    SignalBatch m_pending;
 };
@@ -1,6 +1,24 @@
 #pragma once
 #include <QObject>
 #include <QByteArray>
+#include <QVector>
+
+// One CAN identifier a protocol decodes (11-bit or 29-bit).
+struct CanId {
+    quint32 id = 0;
+    bool    extended = false;
+};
+
+// Fixed-size CAN / CAN FD frame for batched delivery (no heap payload).
+struct RawCanFrame {
+    enum Flag : quint8 { Extended = 0x01, Fd = 0x02, Rtr = 0x04 };
+
+    quint32 id;       // 11/29-bit identifier, flags stripped
+    quint8  len;      // payload bytes, 0..64
+    quint8  flags;
+    quint8  iface;    // index into the transport's interface list
+    uchar   data[64];
+};
 
 class ITransport : public QObject {
     Q_OBJECT
@@ -8,11 +26,30 @@ class ITransport : public QObject {
     using QObject::QObject;
     virtual ~ITransport() = default;
 
+    // What the transport delivers: bytesIn() chunks, or CAN frames through
+    // canIn() (one per emission) or canFrames() (batches).
+    enum class Kind { ByteStream, Can };
+
     virtual bool open() = 0;
     virtual void close() = 0;
     virtual bool isOpen() const = 0;
+    virtual Kind kind() const { return Kind::ByteStream; }
+
+           // Byte-stream transports: send to the device (-1 if unsupported)
+    virtual qint64 write(const QByteArray &data) { Q_UNUSED(data); return -1; }
+
+           // CAN transports: only deliver these ids (empty = everything), e.g.
+           // by installing kernel filters. Default: no filtering.
+    virtual void setCanIds(const QVector<CanId> &ids) { Q_UNUSED(ids); }
+
+           // Receivers are connected and the protocol has started. Transports
+           // that produce input on their own (replay) begin here, not in open().
+    virtual void beginInput() {}
 
   signals:
     void bytesIn(const QByteArray &buf);           // serial/TCP/UDP
-    void canIn(quint32 id, const QByteArray &dlc); // CAN frames (8 bytes)
+    void canIn(quint32 id, const QByteArray &payload, bool extended); // CAN frames, one per emission
+           // Batched CAN frames. `frames` is only valid during the emission,
+           // so connect on the transport's thread (direct connections).
+    void canFrames(const RawCanFrame *frames, int count);
 };
@@ -0,0 +1,145 @@
+#include "latency_tracer.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QVariantMap>
+
+namespace {
+constexpr int kMaxPending = 4096; // no frames (window hidden): stop queueing
+// Applied this long ago and still not synced: no frame was rendered for it
+// (window hidden, nothing dirty), so its wait says nothing about latency
+constexpr qint64 kStaleUs = 100000; // ~6 frames at 60 Hz
+
+int bucketOf(qint64 us) {
+    int b = 0;
+    for (quint64 v = quint64(qMax<qint64>(us, 1)); v > 1; v >>= 1) ++b;
+    return qMin(b, LatencyTracer::kBuckets - 1);
+}
+}
+
+void LatencyTracer::Histogram::add(qint64 us) {
+    us = qMax<qint64>(us, 0);
+    ++buckets[bucketOf(us)];
+    ++count;
+    sumUs += us;
+    maxUs = qMax(maxUs, us);
+}
+
+qint64 LatencyTracer::Histogram::percentileUs(double p) const {
+    if (!count) return 0;
+    const quint64 rank = quint64(p * double(count - 1)) + 1;
+    quint64 seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) return qMin<qint64>((qint64(1) << (b + 1)) - 1, maxUs);
+    }
+    return maxUs;
+}
+
+LatencyTracer::LatencyTracer(QObject *parent) : QObject(parent) {}
+
+const char *LatencyTracer::stageName(int s) {
+    switch (s) {
+    case ArrivalToDecode: return "transport->decode";
+    case DecodeToApply:   return "decode->apply";
+    case ApplyToFrame:    return "apply->frame";
+    default:              return "end-to-end";
+    }
+}
+
+void LatencyTracer::attachWindow(QQuickWindow *win) {
+    connect(win, &QQuickWindow::beforeSynchronizing, this, &LatencyTracer::onBeforeSync, Qt::DirectConnection);
+    connect(win, &QQuickWindow::frameSwapped, this, &LatencyTracer::onFrameSwapped, Qt::DirectConnection);
+}
+
+void LatencyTracer::applied(const Token &t) {
+    QMutexLocker lock(&m_mutex);
+    dropStaleLocked(t.applyUs);
+    if (m_pending.size() < kMaxPending)
+        m_pending.append(t);
+}
+
+void LatencyTracer::dropStaleLocked(qint64 atUs) {
+    // Pending is in apply order: the stale ones are a prefix
+    int n = 0;
+    while (n < m_pending.size() && atUs - m_pending[n].applyUs > kStaleUs) ++n;
+    if (n) m_pending.remove(0, n);
+}
+
+void LatencyTracer::onBeforeSync() {
+    // GUI thread is blocked here: everything applied so far is in this frame
+    const qint64 now = nowUs();
+    QMutexLocker lock(&m_mutex);
+    dropStaleLocked(now);
+    m_inFlight += m_pending;
+    m_pending.clear();
+}
+
+void LatencyTracer::onFrameSwapped() {
+    const qint64 now = nowUs();
+    QMutexLocker lock(&m_mutex);
+    for (const Token &t : std::as_const(m_inFlight)) {
+        m_hist[ArrivalToDecode].add(t.decodeUs - t.arrivalUs);
+        m_hist[DecodeToApply].add(t.applyUs - t.decodeUs);
+        m_hist[ApplyToFrame].add(now - t.applyUs);
+        m_hist[EndToEnd].add(now - t.arrivalUs);
+    }
+    m_inFlight.clear();
+}
+
+QVariantList LatencyTracer::stats() const {
+    QMutexLocker lock(&m_mutex);
+    QVariantList out;
+    for (int s = 0; s < StageCount; ++s) {
+        const Histogram &h = m_hist[s];
+        QVariantMap m;
+        m.insert("stage", QString::fromUtf8(stageName(s)));
+        m.insert("count", double(h.count));
+        m.insert("meanUs", h.count ? double(h.sumUs) / double(h.count) : 0.0);
+        m.insert("p50Us", double(h.percentileUs(0.50)));
+        m.insert("p95Us", double(h.percentileUs(0.95)));
+        m.insert("p99Us", double(h.percentileUs(0.99)));
+        m.insert("maxUs", double(h.maxUs));
+        out.append(m);
+    }
+    return out;
+}
+
+void LatencyTracer::reset() {
+    QMutexLocker lock(&m_mutex);
+    m_hist = {};
+}
+
+QString LatencyTracer::defaultDumpPath() const {
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/latency";
+    QDir().mkpath(dir);
+    return dir + "/latency_" + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss") + ".csv";
+}
+
+bool LatencyTracer::dump(const QString &path) const {
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning("LatencyTracer: cannot write %s", qPrintable(path));
+        return false;
+    }
+    QMutexLocker lock(&m_mutex);
+    QTextStream out(&f);
+    out << "stage,count,mean_us,p50_us,p95_us,p99_us,max_us";
+    for (int b = 0; b < kBuckets; ++b) out << ",lt" << (qint64(1) << (b + 1)) << "us";
+    out << '\n';
+    for (int s = 0; s < StageCount; ++s) {
+        const Histogram &h = m_hist[s];
+        out << stageName(s) << ',' << h.count << ','
+            << (h.count ? double(h.sumUs) / double(h.count) : 0.0) << ','
+            << h.percentileUs(0.50) << ',' << h.percentileUs(0.95) << ','
+            << h.percentileUs(0.99) << ',' << h.maxUs;
+        for (quint64 n : h.buckets) out << ',' << n;
+        out << '\n';
+    }
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <QMutex>
+#include <QObject>
+#include <QVariantList>
+#include <QVector>
+#include <array>
+#include <chrono>
+
+class QQuickWindow;
+
+// Signal-to-photon latency: every protocol batch carries a trace token
+// stamped when its first input bytes arrived from the transport, when the
+// protocol emitted it, when DashModel applied it and when the frame that
+// first shows it was swapped. Stage deltas land in log2 histograms
+// (bucket i = [2^i, 2^(i+1)) µs) that ServicePage reads through stats().
+class LatencyTracer : public QObject {
+    Q_OBJECT
+
+  public:
+    enum Stage { ArrivalToDecode, DecodeToApply, ApplyToFrame, EndToEnd, StageCount };
+    static constexpr int kBuckets = 24; // up to ~16 s
+
+    struct Token {
+        quint64 endSeq = 0;    // producer sample count after this batch (EcuManager)
+        qint64  arrivalUs = 0;
+        qint64  decodeUs = 0;
+        qint64  applyUs = 0;
+    };
+
+    struct Histogram {
+        std::array<quint64, kBuckets> buckets{};
+        quint64 count = 0;
+        qint64  sumUs = 0;
+        qint64  maxUs = 0;
+
+        void   add(qint64 us);
+        qint64 percentileUs(double p) const; // bucket upper bound
+    };
+
+    // Monotonic clock shared by every stamp (any thread).
+    static qint64 nowUs() {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    explicit LatencyTracer(QObject *parent=nullptr);
+
+    // Frame stamps come from beforeSynchronizing/frameSwapped on the
+    // window's render thread.
+    void attachWindow(QQuickWindow *win);
+
+    // GUI thread, right after the batch's samples were applied.
+    void applied(const Token &t);
+
+    Q_INVOKABLE QVariantList stats() const; // one map per stage
+    Q_INVOKABLE void reset();
+    Q_INVOKABLE bool dump(const QString &path) const;
+    Q_INVOKABLE QString defaultDumpPath() const;
+
+  private:
+    void onBeforeSync();
+    void onFrameSwapped();
+    void dropStaleLocked(qint64 atUs); // m_mutex held
+
+    static const char *stageName(int s);
+
+    mutable QMutex m_mutex;
+    QVector<Token> m_pending;  // applied, not yet synced into a frame
+    QVector<Token> m_inFlight; // synced, waiting for swap
+    std::array<Histogram, StageCount> m_hist;
+};
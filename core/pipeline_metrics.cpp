@@ -0,0 +1,98 @@
+#include "pipeline_metrics.h"
+
+#include <QMutexLocker>
+#include <QtAlgorithms>
+
+int PipelineMetrics::Histogram::bucketOf(quint64 v) {
+    if (v < quint64(kSub)) return int(v);
+    int msb = 63 - qCountLeadingZeroBits(v);
+    if (msb >= kMaxBits) return kBuckets - 1;
+    const int shift = msb - kSubBits;
+    return (shift + 1) * kSub + int((v >> shift) & (kSub - 1));
+}
+
+qint64 PipelineMetrics::Histogram::bucketUpper(int b) {
+    if (b < kSub) return b;
+    const int shift = b / kSub - 1;
+    const qint64 lower = qint64(kSub + b % kSub) << shift;
+    return lower + (qint64(1) << shift) - 1;
+}
+
+void PipelineMetrics::Histogram::record(qint64 v) {
+    v = qMax<qint64>(v, 0);
+    m_buckets[bucketOf(quint64(v))].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(v, std::memory_order_relaxed);
+    qint64 m = m_max.load(std::memory_order_relaxed);
+    while (v > m && !m_max.compare_exchange_weak(m, v, std::memory_order_relaxed)) {}
+}
+
+double PipelineMetrics::Histogram::mean() const {
+    const quint64 n = count();
+    return n ? double(m_sum.load(std::memory_order_relaxed)) / double(n) : 0.0;
+}
+
+qint64 PipelineMetrics::Histogram::percentile(double p) const {
+    const quint64 n = count();
+    if (!n) return 0;
+    const quint64 rank = quint64(p * double(n - 1)) + 1;
+    quint64 seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += m_buckets[b].load(std::memory_order_relaxed);
+        if (seen >= rank) return qMin(bucketUpper(b), max());
+    }
+    return max();
+}
+
+PipelineMetrics &PipelineMetrics::instance() {
+    static PipelineMetrics m;
+    return m;
+}
+
+void *PipelineMetrics::find(const QString &name, Kind kind) const {
+    const auto it = m_index.constFind(name);
+    if (it == m_index.cend()) return nullptr;
+    const Entry &e = m_entries[*it];
+    if (e.kind != kind) {
+        qWarning("PipelineMetrics: %s registered with another kind", qPrintable(name));
+        return nullptr;
+    }
+    return e.metric;
+}
+
+PipelineMetrics::Counter *PipelineMetrics::counter(const QString &name) {
+    QMutexLocker lock(&m_mutex);
+    if (void *m = find(name, Kind::Counter)) return static_cast<Counter *>(m);
+    m_counters.emplace_back();
+    m_index.insert(name, m_entries.size());
+    m_entries.append({name, Kind::Counter, &m_counters.back()});
+    return &m_counters.back();
+}
+
+PipelineMetrics::Gauge *PipelineMetrics::gauge(const QString &name) {
+    QMutexLocker lock(&m_mutex);
+    if (void *m = find(name, Kind::Gauge)) return static_cast<Gauge *>(m);
+    m_gauges.emplace_back();
+    m_index.insert(name, m_entries.size());
+    m_entries.append({name, Kind::Gauge, &m_gauges.back()});
+    return &m_gauges.back();
+}
+
+PipelineMetrics::Histogram *PipelineMetrics::histogram(const QString &name) {
+    QMutexLocker lock(&m_mutex);
+    if (void *m = find(name, Kind::Histogram)) return static_cast<Histogram *>(m);
+    m_hists.emplace_back();
+    m_index.insert(name, m_entries.size());
+    m_entries.append({name, Kind::Histogram, &m_hists.back()});
+    return &m_hists.back();
+}
+
+QVector<PipelineMetrics::Entry> PipelineMetrics::entries() const {
+    QMutexLocker lock(&m_mutex);
+    return m_entries;
+}
+
+int PipelineMetrics::count() const {
+    QMutexLocker lock(&m_mutex);
+    return m_entries.size();
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <deque>
+
+// Process-wide pipeline health metrics: named counters, gauges and
+// latency histograms, e.g. "serial.bytesIn", "ecumaster.checksumFailures",
+// "pipeline.queueDepth", "obd2.rttUs".
+//
+// Lookup by name takes a lock and is meant for setup; the returned pointers
+// stay valid for the life of the process, so hot paths cache them and only
+// do relaxed atomic adds. Any thread may record; readers (the QML model,
+// snapshot file) see a consistent-enough view without stopping writers.
+class PipelineMetrics {
+  public:
+    struct Counter {
+        std::atomic<quint64> v{0};
+        void add(quint64 n = 1) { v.fetch_add(n, std::memory_order_relaxed); }
+        quint64 get() const { return v.load(std::memory_order_relaxed); }
+    };
+
+    // Last value plus the high-water mark since start.
+    struct Gauge {
+        std::atomic<qint64> v{0};
+        std::atomic<qint64> hi{0};
+        void set(qint64 x) {
+            v.store(x, std::memory_order_relaxed);
+            qint64 h = hi.load(std::memory_order_relaxed);
+            while (x > h && !hi.compare_exchange_weak(h, x, std::memory_order_relaxed)) {}
+        }
+    };
+
+    // HDR-style log-linear histogram: each power of two is split into
+    // kSub linear sub-buckets, so any recorded value is reported within
+    // 1/kSub (12.5 %) of its true value, from 0 up to 2^40.
+    class Histogram {
+      public:
+        static constexpr int kSubBits = 3;
+        static constexpr int kSub     = 1 << kSubBits;
+        static constexpr int kMaxBits = 40;
+        static constexpr int kBuckets = (kMaxBits - kSubBits + 1) * kSub;
+
+        void record(qint64 v);
+        quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+        qint64  max() const { return m_max.load(std::memory_order_relaxed); }
+        double  mean() const;
+        qint64  percentile(double p) const; // upper edge of the bucket holding p
+
+        static int    bucketOf(quint64 v);
+        static qint64 bucketUpper(int b);
+
+      private:
+        std::array<std::atomic<quint64>, kBuckets> m_buckets{};
+        std::atomic<quint64> m_count{0};
+        std::atomic<qint64>  m_sum{0};
+        std::atomic<qint64>  m_max{0};
+    };
+
+    enum class Kind { Counter, Gauge, Histogram };
+
+    struct Entry {
+        QString name;
+        Kind    kind;
+        void   *metric; // Counter*, Gauge* or Histogram* per kind
+    };
+
+    static PipelineMetrics &instance();
+
+    Counter   *counter(const QString &name);
+    Gauge     *gauge(const QString &name);
+    Histogram *histogram(const QString &name);
+
+    QVector<Entry> entries() const; // registration order
+    int count() const;
+
+  private:
+    PipelineMetrics() = default;
+    void *find(const QString &name, Kind kind) const;
+
+    mutable QMutex m_mutex;
+    std::deque<Counter>   m_counters; // deque: addresses never move
+    std::deque<Gauge>     m_gauges;
+    std::deque<Histogram> m_hists;
+    QVector<Entry> m_entries;
+    QHash<QString, int> m_index; // name -> m_entries
+};
@@ -0,0 +1,161 @@
+#include "pipeline_metrics_model.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+namespace {
+const char *kindName(PipelineMetrics::Kind k) {
+    switch (k) {
+    case PipelineMetrics::Kind::Counter:   return "counter";
+    case PipelineMetrics::Kind::Gauge:     return "gauge";
+    case PipelineMetrics::Kind::Histogram: return "histogram";
+    }
+    return "";
+}
+}
+
+PipelineMetricsModel::PipelineMetricsModel(QObject *parent) : QAbstractListModel(parent) {
+    m_refresh.setInterval(1000);
+    connect(&m_refresh, &QTimer::timeout, this, &PipelineMetricsModel::refresh);
+    m_refresh.start();
+    connect(&m_snapTimer, &QTimer::timeout, this, [this] { writeSnapshot(m_snapPath); });
+    refresh();
+}
+
+void PipelineMetricsModel::setRefreshMs(int ms) {
+    ms = qMax(100, ms);
+    if (ms == m_refresh.interval()) return;
+    m_refresh.setInterval(ms);
+    emit refreshMsChanged();
+}
+
+void PipelineMetricsModel::setSnapshot(const QString &path, int intervalSec) {
+    m_snapPath = path;
+    if (intervalSec > 0 && !path.isEmpty())
+        m_snapTimer.start(intervalSec * 1000);
+    else
+        m_snapTimer.stop();
+}
+
+void PipelineMetricsModel::refresh() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const double dt = m_lastRefreshMs ? (now - m_lastRefreshMs) / 1000.0 : 0.0;
+    m_lastRefreshMs = now;
+
+    const QVector<PipelineMetrics::Entry> all = PipelineMetrics::instance().entries();
+    if (all.size() != m_rows.size()) {
+        // Metrics are only ever appended; keep the existing rows' rate state
+        beginInsertRows(QModelIndex(), m_rows.size(), all.size() - 1);
+        for (int i = m_rows.size(); i < all.size(); ++i)
+            m_rows.append(Row{all[i]});
+        endInsertRows();
+    }
+
+    for (Row &r : m_rows) {
+        if (r.e.kind != PipelineMetrics::Kind::Counter) continue;
+        const quint64 v = static_cast<const PipelineMetrics::Counter *>(r.e.metric)->get();
+        r.rate = dt > 0.0 ? double(v - r.last) / dt : 0.0;
+        r.last = v;
+    }
+    if (!m_rows.isEmpty())
+        emit dataChanged(index(0), index(m_rows.size() - 1));
+}
+
+int PipelineMetricsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant PipelineMetricsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_rows.size()) return {};
+    const Row &r = m_rows[index.row()];
+    using Kind = PipelineMetrics::Kind;
+    if (role == NameRole || role == Qt::DisplayRole) return r.e.name;
+    if (role == KindRole) return QString::fromLatin1(kindName(r.e.kind));
+
+    switch (r.e.kind) {
+    case Kind::Counter: {
+        const auto *c = static_cast<const PipelineMetrics::Counter *>(r.e.metric);
+        if (role == ValueRole) return double(c->get());
+        if (role == RateRole)  return r.rate;
+        break;
+    }
+    case Kind::Gauge: {
+        const auto *g = static_cast<const PipelineMetrics::Gauge *>(r.e.metric);
+        if (role == ValueRole) return double(g->v.load(std::memory_order_relaxed));
+        if (role == PeakRole)  return double(g->hi.load(std::memory_order_relaxed));
+        break;
+    }
+    case Kind::Histogram: {
+        const auto *h = static_cast<const PipelineMetrics::Histogram *>(r.e.metric);
+        if (role == ValueRole) return double(h->count());
+        if (role == PeakRole)  return double(h->max());
+        if (role == MeanRole)  return h->mean();
+        if (role == P50Role)   return double(h->percentile(0.50));
+        if (role == P99Role)   return double(h->percentile(0.99));
+        break;
+    }
+    }
+    return {};
+}
+
+QHash<int, QByteArray> PipelineMetricsModel::roleNames() const {
+    return {
+        {NameRole, "name"},
+        {KindRole, "kind"},
+        {ValueRole, "value"},
+        {RateRole, "rate"},
+        {PeakRole, "peak"},
+        {MeanRole, "mean"},
+        {P50Role, "p50"},
+        {P99Role, "p99"},
+    };
+}
+
+bool PipelineMetricsModel::writeSnapshot(const QString &path) const {
+    if (path.isEmpty()) return false;
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QJsonObject counters, gauges, hists;
+    for (const PipelineMetrics::Entry &e : PipelineMetrics::instance().entries()) {
+        switch (e.kind) {
+        case PipelineMetrics::Kind::Counter:
+            counters.insert(e.name, double(static_cast<const PipelineMetrics::Counter *>(e.metric)->get()));
+            break;
+        case PipelineMetrics::Kind::Gauge: {
+            const auto *g = static_cast<const PipelineMetrics::Gauge *>(e.metric);
+            gauges.insert(e.name, QJsonObject{{"value", double(g->v.load(std::memory_order_relaxed))},
+                                              {"max", double(g->hi.load(std::memory_order_relaxed))}});
+            break;
+        }
+        case PipelineMetrics::Kind::Histogram: {
+            const auto *h = static_cast<const PipelineMetrics::Histogram *>(e.metric);
+            hists.insert(e.name, QJsonObject{{"count", double(h->count())},
+                                             {"mean", h->mean()},
+                                             {"p50", double(h->percentile(0.50))},
+                                             {"p90", double(h->percentile(0.90))},
+                                             {"p99", double(h->percentile(0.99))},
+                                             {"max", double(h->max())}});
+            break;
+        }
+        }
+    }
+    QJsonObject root;
+    root.insert("time", QDateTime::currentDateTime().toString(Qt::ISODateWithMs));
+    root.insert("counters", counters);
+    root.insert("gauges", gauges);
+    root.insert("histograms", hists);
+
+    // Atomic replace: a crash mid-write keeps the previous snapshot
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning("PipelineMetricsModel: cannot write %s", qPrintable(path));
+        return false;
+    }
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return f.commit();
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QTimer>
+#include "core/pipeline_metrics.h"
+
+// QML list of every PipelineMetrics entry, refreshed on a timer (rows are
+// re-read, not re-created, unless new metrics were registered). Optionally
+// writes the same snapshot as JSON to snapshotPath every snapshotSec so a
+// flaky link can be diagnosed after the fact.
+class PipelineMetricsModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int refreshMs READ refreshMs WRITE setRefreshMs NOTIFY refreshMsChanged)
+
+  public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        KindRole,   // "counter" | "gauge" | "histogram"
+        ValueRole,  // counter total, gauge value, histogram count
+        RateRole,   // counter: per second over the last refresh
+        PeakRole,   // gauge high-water, histogram max
+        MeanRole,
+        P50Role,
+        P99Role,
+    };
+
+    explicit PipelineMetricsModel(QObject *parent=nullptr);
+
+    int  refreshMs() const { return m_refresh.interval(); }
+    void setRefreshMs(int ms);
+
+    void setSnapshot(const QString &path, int intervalSec); // intervalSec <= 0 disables
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE void refresh();
+    Q_INVOKABLE bool writeSnapshot(const QString &path) const;
+    Q_INVOKABLE QString snapshotPath() const { return m_snapPath; }
+
+  signals:
+    void refreshMsChanged();
+
+  private:
+    struct Row {
+        PipelineMetrics::Entry e;
+        quint64 last = 0;   // counter value at the previous refresh
+        double  rate = 0.0;
+    };
+
+    QVector<Row> m_rows;
+    QTimer m_refresh;
+    QTimer m_snapTimer;
+    QString m_snapPath;
+    qint64 m_lastRefreshMs{0};
+};
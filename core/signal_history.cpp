@@ -0,0 +1,120 @@
+#include "signal_history.h"
+#include "signal_registry.h"
+
+SignalHistory::SignalHistory(QObject *parent) : QObject(parent), m_notify(this) {
+    m_notify.setSingleShot(true);
+    m_notify.setInterval(kNotifyMs);
+    connect(&m_notify, &QTimer::timeout, this, &SignalHistory::updated);
+    setBudgetKb(m_budgetKb);
+}
+
+void SignalHistory::setBudgetKb(int kb) {
+    kb = qMax(1, kb);
+    // Largest power of two that fits kMaxSignals rings into the budget
+    const qint64 perSignal = qint64(kb) * 1024 / (kMaxSignals * kBytesPerSample);
+    quint32 cap = kMinCapacity;
+    while (qint64(cap) * 2 <= perSignal) cap *= 2;
+
+    const bool changed = kb != m_budgetKb || cap != m_capacity;
+    m_budgetKb = kb;
+    m_capacity = cap;
+    clear();
+    if (changed) emit budgetChanged();
+}
+
+void SignalHistory::clear() {
+    m_rings.clear();
+    m_rings.reserve(kMaxSignals); // ring() pointers stay valid while growing
+    m_ringOf.clear();
+    m_epoch = -1;
+    m_latest = 0;
+    emit updated();
+}
+
+SignalHistory::Ring *SignalHistory::ringFor(SignalId id) {
+    if (id >= m_ringOf.size()) m_ringOf.resize(id + 1, -1);
+    int r = m_ringOf[id];
+    if (r >= 0) return &m_rings[r];
+    if (m_rings.size() >= kMaxSignals) return nullptr;
+
+    Ring ring;
+    ring.id = id;
+    ring.t.resize(m_capacity);
+    ring.v.resize(m_capacity);
+    ring.bmin.resize(int(m_capacity >> kBlockBits));
+    ring.bmax.resize(int(m_capacity >> kBlockBits));
+    ring.bsum.resize(int(m_capacity >> kBlockBits));
+    ring.mask = m_capacity - 1;
+    m_rings.append(ring);
+    m_ringOf[id] = m_rings.size() - 1;
+    return &m_rings.last();
+}
+
+void SignalHistory::onBatch(const SignalBatch &batch) {
+    if (batch.isEmpty()) return;
+    if (m_epoch < 0) m_epoch = batch.first().t_ms;
+    for (const SignalUpdate &u : batch) {
+        Ring *r = ringFor(u.id);
+        if (!r) continue;
+        const quint32 t = quint32(qMax<qint64>(0, u.t_ms - m_epoch));
+        r->append(t, float(u.value));
+        m_latest = qMax(m_latest, t);
+    }
+    if (!m_notify.isActive()) m_notify.start();
+}
+
+SignalHistory::Window SignalHistory::window(SignalId id, qint64 windowMs) const {
+    Window w;
+    const Ring *r = ring(id);
+    if (!r || !r->size()) return w;
+
+    const qint64 from = windowMs > 0 ? qint64(m_latest) - windowMs : -1;
+    float mn = qInf(), mx = -qInf();
+    double sum = 0.0;
+    int n = 0;
+    // Newest to oldest (absolute sample numbers); stops at the first sample
+    // outside the window. A block is taken from its summary when it is
+    // complete, not partly overwritten and starts inside the window.
+    const qint64 lo = qint64(r->head) - r->size();
+    for (qint64 k = qint64(r->head) - 1; k >= lo;) {
+        const qint64 first = k & ~qint64(kBlock - 1);
+        if (k - first == kBlock - 1 && first >= lo && qint64(r->t[quint32(first) & r->mask]) >= from) {
+            const int b = int((quint32(first) & r->mask) >> kBlockBits);
+            mn = r->bmin[b] < mn ? r->bmin[b] : mn;
+            mx = r->bmax[b] > mx ? r->bmax[b] : mx;
+            sum += r->bsum[b];
+            n += kBlock;
+            k -= kBlock;
+            continue;
+        }
+        const quint32 s = quint32(k) & r->mask;
+        if (qint64(r->t[s]) < from) break;
+        const float v = r->v[s];
+        mn = v < mn ? v : mn;
+        mx = v > mx ? v : mx;
+        sum += v;
+        ++n;
+        --k;
+    }
+    if (n) {
+        w.min = mn;
+        w.max = mx;
+        w.avg = sum / n;
+        w.count = n;
+    }
+    return w;
+}
+
+QVariantMap SignalHistory::stats(const QString &signal, int windowMs) const {
+    const Window w = window(SignalRegistry::instance().find(signal), windowMs);
+    QVariantMap m;
+    m.insert("min", w.min);
+    m.insert("max", w.max);
+    m.insert("avg", w.avg);
+    m.insert("count", w.count);
+    return m;
+}
+
+double SignalHistory::peak(const QString &signal, int windowMs) const {
+    return window(SignalRegistry::instance().find(signal), windowMs).max;
+}
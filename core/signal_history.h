@@ -0,0 +1,106 @@
+#pragma once
+#include <QObject>
+#include <QTimer>
+#include <QVariantMap>
+#include <QVector>
+#include "core/signal_types.h"
+
+// Recent history of every signal, for sparklines, peak-hold and min/max
+// readouts without QML accumulating arrays.
+//
+// Each signal gets a fixed-capacity ring stored as two parallel arrays
+// (time, value), plus a min/max/sum summary per block of kBlock slots kept
+// up to date on append. A windowed query reads whole blocks from their
+// summaries and scans only the partial blocks at either end, so it costs
+// O(window / kBlock + kBlock) rather than O(window). Rings are allocated on
+// a signal's first sample, up to kMaxSignals, with a per-signal capacity
+// derived from the memory budget (KeyDash/historyBudgetKb), so the total is
+// bounded on the dash hardware.
+// GUI thread only.
+class SignalHistory : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int budgetKb READ budgetKb WRITE setBudgetKb NOTIFY budgetChanged)
+    Q_PROPERTY(int capacityPerSignal READ capacityPerSignal NOTIFY budgetChanged)
+
+  public:
+    static constexpr int kMaxSignals     = 32;
+    static constexpr int kMinCapacity    = 256;
+    static constexpr int kBytesPerSample = 8;   // time + value; block summaries add 1/4
+    static constexpr int kNotifyMs       = 50;  // updated() at most this often
+    static constexpr int kBlockBits      = 6;
+    static constexpr int kBlock          = 1 << kBlockBits; // samples per summary
+
+    struct Ring {
+        SignalId         id = Sig::Invalid;
+        QVector<quint32> t;        // ms since the store's epoch
+        QVector<float>   v;
+        QVector<float>   bmin;     // per block of kBlock slots
+        QVector<float>   bmax;
+        QVector<double>  bsum;
+        quint64          head = 0; // samples ever appended
+        quint32          mask = 0;
+
+        int size() const { return int(qMin<quint64>(head, quint64(mask) + 1)); }
+        void append(quint32 tt, float vv) {
+            const quint32 s = quint32(head++) & mask;
+            t[s] = tt;
+            v[s] = vv;
+            const int b = int(s >> kBlockBits);
+            if (!(s & (kBlock - 1))) { // first slot: the block starts over
+                bmin[b] = bmax[b] = vv;
+                bsum[b] = vv;
+            } else {
+                bmin[b] = vv < bmin[b] ? vv : bmin[b];
+                bmax[b] = vv > bmax[b] ? vv : bmax[b];
+                bsum[b] += vv;
+            }
+        }
+        // i-th oldest retained sample, 0 <= i < size()
+        quint32 slot(int i) const { return quint32(head - quint64(size()) + quint64(i)) & mask; }
+    };
+
+    struct Window {
+        float  min = 0.0f;
+        float  max = 0.0f;
+        double avg = 0.0;
+        int    count = 0;
+    };
+
+    explicit SignalHistory(QObject *parent=nullptr);
+
+    int  budgetKb() const { return m_budgetKb; }
+    void setBudgetKb(int kb); // clears the history
+    int  capacityPerSignal() const { return int(m_capacity); }
+
+    const Ring *ring(SignalId id) const {
+        const int r = id < m_ringOf.size() ? m_ringOf[id] : -1;
+        return r < 0 ? nullptr : &m_rings[r];
+    }
+    qint64 epochMs() const { return m_epoch; }
+    qint64 latestMs() const { return m_epoch + m_latest; }
+
+    // Samples newer than latestMs() - windowMs (windowMs <= 0: everything).
+    Window window(SignalId id, qint64 windowMs) const;
+
+    Q_INVOKABLE QVariantMap stats(const QString &signal, int windowMs) const; // min/max/avg/count
+    Q_INVOKABLE double peak(const QString &signal, int windowMs) const;
+    Q_INVOKABLE void clear();
+
+  public slots:
+    void onBatch(const SignalBatch &batch);
+
+  signals:
+    void budgetChanged();
+    void updated(); // coalesced to once per kNotifyMs
+
+  private:
+    Ring *ringFor(SignalId id);
+
+    int m_budgetKb{1024};
+    quint32 m_capacity{kMinCapacity};
+    QVector<int> m_ringOf;      // SignalId -> m_rings index, -1 = none
+    QVector<Ring> m_rings;
+    qint64 m_epoch{-1};         // absolute ms of t == 0
+    quint32 m_latest{0};
+    QTimer m_notify;
+};
@@ -0,0 +1,96 @@
+#include "signal_history_model.h"
+#include "signal_registry.h"
+
+SignalHistoryModel::SignalHistoryModel(QObject *parent) : QAbstractListModel(parent) {}
+
+void SignalHistoryModel::setSource(QObject *s) {
+    SignalHistory *h = qobject_cast<SignalHistory *>(s);
+    if (h == m_src) return;
+    if (m_src) disconnect(m_src, nullptr, this, nullptr);
+    m_src = h;
+    if (m_src) connect(m_src, &SignalHistory::updated, this, &SignalHistoryModel::onUpdated);
+    rebind();
+    emit sourceChanged();
+}
+
+void SignalHistoryModel::setSignalName(const QString &name) {
+    if (name == m_name) return;
+    m_name = name;
+    rebind();
+    emit signalNameChanged();
+}
+
+void SignalHistoryModel::rebind() {
+    beginResetModel();
+    // Lookup only: unknown names (typos, signals of another protocol) bind
+    // to nothing instead of growing the registry; onUpdated() retries
+    m_id = m_name.isEmpty() ? SignalId(Sig::Invalid)
+                           : SignalRegistry::instance().find(m_name);
+    const SignalHistory::Ring *r = ring();
+    m_rows = r ? r->size() : 0;
+    m_seenHead = r ? r->head : 0;
+    endResetModel();
+    emit countChanged();
+}
+
+const SignalHistory::Ring *SignalHistoryModel::ring() const {
+    return m_src ? m_src->ring(m_id) : nullptr;
+}
+
+void SignalHistoryModel::onUpdated() {
+    if (m_id == Sig::Invalid && !m_name.isEmpty()) { // interned after we bound?
+        if (SignalRegistry::instance().find(m_name) != Sig::Invalid) rebind();
+        return;
+    }
+    const SignalHistory::Ring *r = ring();
+    const int rows = r ? r->size() : 0;
+    const quint64 head = r ? r->head : 0;
+    if (head < m_seenHead || rows < m_rows) { // store cleared
+        rebind();
+        return;
+    }
+    if (head == m_seenHead) return;
+
+    const int old = m_rows;
+    if (rows > old) {
+        beginInsertRows(QModelIndex(), old, rows - 1);
+        m_rows = rows;
+        endInsertRows();
+        emit countChanged();
+    }
+    // Once the ring wraps every row shifts by the number of new samples
+    if (head - m_seenHead > quint64(rows - old) && old > 0)
+        emit dataChanged(index(0), index(old - 1));
+    m_seenHead = head;
+}
+
+int SignalHistoryModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_rows;
+}
+
+QVariant SignalHistoryModel::data(const QModelIndex &index, int role) const {
+    const SignalHistory::Ring *r = ring();
+    if (!r || !index.isValid() || index.row() >= r->size()) return {};
+    const quint32 s = r->slot(index.row());
+    switch (role) {
+    case TimeRole:  return double(m_src->epochMs() + r->t[s]);
+    case AgeRole:   return double(m_src->latestMs() - (m_src->epochMs() + r->t[s]));
+    case ValueRole:
+    case Qt::DisplayRole: return double(r->v[s]);
+    default: return {};
+    }
+}
+
+QHash<int, QByteArray> SignalHistoryModel::roleNames() const {
+    return {
+        {TimeRole, "time"},
+        {AgeRole, "age"},
+        {ValueRole, "value"},
+    };
+}
+
+double SignalHistoryModel::valueAt(int row) const {
+    const SignalHistory::Ring *r = ring();
+    if (!r || row < 0 || row >= r->size()) return qQNaN();
+    return r->v[r->slot(row)];
+}
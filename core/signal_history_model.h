@@ -0,0 +1,53 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QPointer>
+#include "core/signal_history.h"
+
+// List view onto one SignalHistory ring, oldest sample first. data() reads
+// the ring in place (no copy); rows are inserted while the ring fills and
+// reported as changed once it wraps.
+class SignalHistoryModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(QObject *source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(QString signalName READ signalName WRITE setSignalName NOTIFY signalNameChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  public:
+    enum Roles {
+        TimeRole = Qt::UserRole + 1, // absolute ms
+        AgeRole,                     // ms before the newest sample in the store
+        ValueRole,
+    };
+
+    explicit SignalHistoryModel(QObject *parent=nullptr);
+
+    QObject *source() const { return m_src.data(); }
+    void     setSource(QObject *s);
+    QString  signalName() const { return m_name; }
+    void     setSignalName(const QString &name);
+    int      count() const { return rowCount(); }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE double valueAt(int row) const; // for Canvas loops
+
+  signals:
+    void sourceChanged();
+    void signalNameChanged();
+    void countChanged();
+
+  private slots:
+    void onUpdated();
+
+  private:
+    const SignalHistory::Ring *ring() const;
+    void rebind();
+
+    QPointer<SignalHistory> m_src;
+    QString m_name;
+    SignalId m_id{Sig::Invalid};
+    int m_rows{0};
+    quint64 m_seenHead{0};
+};
@@ -0,0 +1,70 @@
+#include "signal_registry.h"
+
+SignalRegistry &SignalRegistry::instance() {
+    static SignalRegistry reg;
+    return reg;
+}
+
+SignalRegistry::SignalRegistry() {
+    // Order must match the Sig:: enum.
+    static const char *const kWellKnown[] = {
+        "",                   // Sig::Invalid
+        "Engine.RPM",         // Sig::EngineRpm
+        "Vehicle.SpeedKph",   // Sig::VehicleSpeedKph
+        "Temps.CLT_C",        // Sig::TempsCltC
+        "Temps.IAT_C",        // Sig::TempsIatC
+        "Engine.TPS_Percent", // Sig::EngineTpsPercent
+        "Engine.MAP_kPa",     // Sig::EngineMapKpa
+        "Engine.Boost_PSI",   // Sig::EngineBoostPsi
+        "Engine.Baro_kPa",    // Sig::EngineBaroKpa
+        "Electrical.Vbat_V",  // Sig::ElectricalVbat
+        "Lambda.AFR",         // Sig::LambdaAfr
+        "Lambda.Lambda",      // Sig::LambdaLambda
+        "Drivetrain.Gear",    // Sig::DrivetrainGear
+    };
+    static_assert(sizeof(kWellKnown) / sizeof(kWellKnown[0]) == Sig::WellKnownCount,
+                  "kWellKnown out of sync with Sig::");
+    for (const char *n : kWellKnown)
+        insertLocked(QString::fromLatin1(n));
+}
+
+SignalId SignalRegistry::insertLocked(const QString &name) {
+    const SignalId id = SignalId(m_names.size());
+    m_names.append(name);
+    if (!name.isEmpty())
+        m_ids.insert(name, id);
+    return id;
+}
+
+SignalId SignalRegistry::intern(const QString &name) {
+    if (name.isEmpty())
+        return Sig::Invalid;
+    {
+        QReadLocker rl(&m_lock);
+        const auto it = m_ids.constFind(name);
+        if (it != m_ids.constEnd())
+            return it.value();
+    }
+    QWriteLocker wl(&m_lock);
+    const auto it = m_ids.constFind(name); // raced with another intern()?
+    if (it != m_ids.constEnd())
+        return it.value();
+    if (m_names.size() > 0xFFFF)
+        return Sig::Invalid;
+    return insertLocked(name);
+}
+
+SignalId SignalRegistry::find(const QString &name) const {
+    QReadLocker rl(&m_lock);
+    return m_ids.value(name, Sig::Invalid);
+}
+
+QString SignalRegistry::name(SignalId id) const {
+    QReadLocker rl(&m_lock);
+    return id < m_names.size() ? m_names.at(id) : QString();
+}
+
+int SignalRegistry::count() const {
+    QReadLocker rl(&m_lock);
+    return int(m_names.size());
+}
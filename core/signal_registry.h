@@ -0,0 +1,30 @@
+#pragma once
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+#include "signal_types.h"
+
+// Process-wide name <-> SignalId table.
+//
+// Protocols intern their signal names once when they start and afterwards
+// only pass the compact id around; names are for QML and logging.
+// The well-known ids in signal_types.h are registered up front so their
+// values are stable and usable as switch labels.
+class SignalRegistry {
+  public:
+    static SignalRegistry &instance();
+
+    SignalId intern(const QString &name);      // returns existing id if known
+    SignalId find(const QString &name) const;  // Sig::Invalid if unknown
+    QString  name(SignalId id) const;          // empty if unknown
+    int      count() const;
+
+  private:
+    SignalRegistry();
+    SignalId insertLocked(const QString &name);
+
+    mutable QReadWriteLock   m_lock;
+    QHash<QString, SignalId> m_ids;
+    QStringList              m_names; // indexed by id
+};
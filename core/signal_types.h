@@ -1,11 +1,40 @@
 #pragma once
-#include <QString>
 #include <QMetaType>
+#include <QVector>
 #include <QtGlobal>
 
+// Compact signal identifier; see SignalRegistry for the name mapping.
+using SignalId = quint16;
+
+// Well-known signal ids (pre-registered by SignalRegistry in this order).
+namespace Sig {
+enum : SignalId {
+    Invalid = 0,
+    EngineRpm,        // "Engine.RPM"
+    VehicleSpeedKph,  // "Vehicle.SpeedKph"
+    TempsCltC,        // "Temps.CLT_C"
+    TempsIatC,        // "Temps.IAT_C"
+    EngineTpsPercent, // "Engine.TPS_Percent"
+    EngineMapKpa,     // "Engine.MAP_kPa"
+    EngineBoostPsi,   // "Engine.Boost_PSI"
+    EngineBaroKpa,    // "Engine.Baro_kPa"
+    ElectricalVbat,   // "Electrical.Vbat_V"
+    LambdaAfr,        // "Lambda.AFR"
+    LambdaLambda,     // "Lambda.Lambda"
+    DrivetrainGear,   // "Drivetrain.Gear"
+    WellKnownCount
+};
+}
+
+// One normalized sample. Plain data: no heap, cheap to copy and queue.
 struct SignalUpdate {
-    QString name;     // e.g., "Engine.RPM"
-    double value{0};  // normalized numeric
-    qint64 t_ms{0};   // epoch ms
+    SignalId id{Sig::Invalid};
+    double   value{0}; // normalized numeric
+    qint64   t_ms{0};  // epoch ms
 };
 Q_DECLARE_METATYPE(SignalUpdate)
+
+// Samples produced by one transport read / protocol tick, delivered as a
+// single signal emission (implicitly shared; queued copies are O(1)).
+using SignalBatch = QVector<SignalUpdate>;
+Q_DECLARE_METATYPE(SignalBatch)
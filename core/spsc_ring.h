@@ -0,0 +1,51 @@
+#pragma once
+#include <QtGlobal>
+#include <atomic>
+
+// Bounded lock-free single-producer / single-consumer ring.
+//
+// push() is called from exactly one thread (the I/O thread), pop() from
+// exactly one other thread (the GUI thread). Head and tail live on separate
+// cache lines so the two sides don't false-share.
+template <typename T, quint32 Capacity> class SpscRing {
+    static_assert(Capacity && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+  public:
+    static constexpr quint32 capacity() { return Capacity; }
+
+    // Producer side. Returns false (and drops v) when the ring is full.
+    bool push(const T &v) {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        const quint32 tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail >= Capacity)
+            return false;
+        m_slots[head & kMask] = v;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Copies up to `max` items into dst, returns the count.
+    quint32 pop(T *dst, quint32 max) {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        const quint32 head = m_head.load(std::memory_order_acquire);
+        const quint32 n    = qMin(head - tail, max);
+        for (quint32 i = 0; i < n; ++i)
+            dst[i] = m_slots[(tail + i) & kMask];
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Approximate when called concurrently; exact from either side's view
+    // of its own progress.
+    quint32 size() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr quint32 kMask = Capacity - 1;
+
+    alignas(64) std::atomic<quint32> m_head{0};
+    alignas(64) std::atomic<quint32> m_tail{0};
+    alignas(64) T m_slots[Capacity];
+};
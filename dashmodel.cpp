@@ -4,7 +4,9 @@
 #include <QtMath>
 #include "dashmodel.h"
 #include <QtGlobal>
+#include <QtAlgorithms>
 #include <QDateTime>
+#include "core/signal_registry.h"
 
 DashModel::DashModel(QObject *parent)
     : QObject(parent), m_gears(10, 0.0) // allow gears 1..9 by default
@@ -18,26 +20,127 @@ DashModel::DashModel(QObject *parent)
   // m_gears[6].. as needed
 }
 
+/* Update coalescing */
+
+namespace {
+using Notify = void (DashModel::*)();
+// Indexed by DashModel::Prop
+const Notify kNotify[] = {
+    &DashModel::speedChanged,       &DashModel::rpmChanged,
+    &DashModel::boostChanged,       &DashModel::cltChanged,
+    &DashModel::iatChanged,         &DashModel::vbatChanged,
+    &DashModel::afrChanged,         &DashModel::gearChanged,
+    &DashModel::odoChanged,         &DashModel::tripChanged,
+    &DashModel::leftSignalChanged,  &DashModel::rightSignalChanged,
+    &DashModel::headlightsOnChanged, &DashModel::celOnChanged,
+    &DashModel::tcsOnChanged,
+};
+} // namespace
+
+void DashModel::changed(Prop p) {
+  static_assert(sizeof(kNotify) / sizeof(kNotify[0]) == PropCount,
+                "kNotify out of sync with DashModel::Prop");
+  if (!m_coalesce) {
+    ++m_notifyEmitted;
+    emit (this->*kNotify[p])();
+    return;
+  }
+  const quint32 bit = 1u << p;
+  if (m_dirty & bit) {
+    ++m_notifySaved; // superseded before it was ever shown
+    return;
+  }
+  const bool first = (m_dirty == 0);
+  m_dirty |= bit;
+  if (first)
+    emit flushRequested();
+}
+
+void DashModel::flushPending() {
+  if (!m_dirty)
+    return;
+  ++m_flushes;
+  quint32 d = m_dirty;
+  m_dirty = 0; // handlers may dirty values again; they go to the next frame
+  while (d) {
+    const int p = qCountTrailingZeroBits(d);
+    d &= d - 1;
+    ++m_notifyEmitted;
+    emit (this->*kNotify[p])();
+  }
+}
+
+void DashModel::setCoalesceUpdates(bool on) {
+  if (m_coalesce == on)
+    return;
+  m_coalesce = on;
+  if (!on)
+    flushPending();
+  emit coalesceUpdatesChanged();
+}
+
+QVariantMap DashModel::coalesceStats() const {
+  QVariantMap m;
+  m.insert("notificationsEmitted", m_notifyEmitted);
+  m.insert("notificationsSaved", m_notifySaved);
+  m.insert("flushes", m_flushes);
+  return m;
+}
+
 static inline double kPaToPsi(double kpa) { return kpa * 0.1450377377; }
 
 void DashModel::onSignal(const SignalUpdate &up) {
-    if (up.name == "Engine.RPM") {
+    switch (up.id) {
+    case Sig::EngineRpm:
         setRpm(int(up.value + 0.5));
-    } else if (up.name == "Vehicle.SpeedKph") {
+        break;
+    case Sig::VehicleSpeedKph:
         setSpeed(up.value);
-    } else if (up.name == "Temps.CLT_C") {
+        break;
+    case Sig::TempsCltC:
         setClt(up.value);
-    } else if (up.name == "Temps.IAT_C") {
+        break;
+    case Sig::TempsIatC:
         setIat(up.value);
-    } else if (up.name == "Engine.MAP_kPa") {
-        // absolute kPa -> gauge psi (subtract atmospheric ~101.325 kPa)
-        const double boostPsi = kPaToPsi(up.value - 101.325);
-        setBoost(boostPsi);
-    } else if (up.name == "Engine.Boost_PSI") {
+        break;
+    case Sig::EngineMapKpa:
+        // absolute kPa -> gauge psi (subtract measured or standard baro)
+        setBoost(kPaToPsi(up.value - m_baroKpa));
+        break;
+    case Sig::EngineBoostPsi:
         setBoost(up.value);
+        break;
+    case Sig::EngineBaroKpa:
+        if (up.value > 50.0 && up.value < 120.0) // ignore implausible baro
+            m_baroKpa = up.value;
+        break;
+    case Sig::ElectricalVbat:
+        setVbat(up.value);
+        break;
+    case Sig::LambdaAfr:
+        setAfr(up.value);
+        break;
+    case Sig::DrivetrainGear:
+        setGear(int(up.value));
+        break;
+    default:
+        break;
     }
 }
 
+void DashModel::onBatch(const SignalBatch &batch) {
+    for (const SignalUpdate &up : batch)
+        onSignal(up);
+}
+
+QString DashModel::signalName(int id) const {
+    return (id >= 0 && id <= 0xFFFF) ? SignalRegistry::instance().name(SignalId(id)) : QString();
+}
+
+int DashModel::signalId(const QString &name) const {
+    return SignalRegistry::instance().find(name);
+}
+
 void DashModel::setUseMph(bool v) {
   if (m_useMph == v)
     return;
@@ -124,7 +227,7 @@ static inline double getNum(const QVariantMap &m, const char *key,
 
 // (2) Ingest a replay frame (called by ReplayPage)
 void DashModel::ingestFrame(const QVariantMap &f) {
-  // Extract commonly-logged fields (matches LogParser.normalizeRow()).
+  // Extract commonly-logged fields (same short names as ReplayLog::fieldFor()).
   const double rpm = qIsNaN(getNum(f, "rpm")) ? m_rpm : getNum(f, "rpm");
   const double mph = getNum(f, "speed");         // optional if your log has it
   const double mapk = getNum(f, "map");          // kPa (absolute)
@@ -37,6 +37,10 @@ class DashModel : public QObject {
     // ECU connection status (used by UI connection banner)
     Q_PROPERTY(bool connected READ connected WRITE setConnected NOTIFY connectedChanged)
 
+    // Latest-value-wins mode: telemetry NOTIFYs are held back and emitted at
+    // most once per rendered frame by flushPending().
+    Q_PROPERTY(bool coalesceUpdates READ coalesceUpdates WRITE setCoalesceUpdates NOTIFY coalesceUpdatesChanged)
+
 public:
     explicit DashModel(QObject* parent=nullptr);
 
@@ -62,6 +66,7 @@ public:
     bool    tcsOn()        const { return m_tcsOn; }
     bool    z60Popup()     const { return m_z60Popup; }
     bool    connected()    const { return m_connected; }
+    bool    coalesceUpdates() const { return m_coalesce; }
 
     void setZ60Popup(bool v) {
         if (m_z60Popup == v) return;
@@ -73,29 +78,39 @@ public:
     Q_INVOKABLE void setReplayMode(bool on);           // pause live source while replaying
     Q_INVOKABLE void ingestFrame(const QVariantMap &); // main entry from ReplayPage
 
+    // Coalescing counters: notificationsEmitted / notificationsSaved / flushes
+    Q_INVOKABLE QVariantMap coalesceStats() const;
+
+    // Signal id <-> name (QML/logging only; the data path uses ids)
+    Q_INVOKABLE QString signalName(int id) const;
+    Q_INVOKABLE int signalId(const QString &name) const;
+
 public slots:
     // setters
     void setUseMph(bool v);
     void setRpmMax(int v);
     void setFinalDrive(double v);
-    void setSpeed(double v){ if (v!=m_speed){ m_speed=v; emit speedChanged(); } }
-    void setRpm(double v){ if (v!=m_rpm){ m_rpm=v; emit rpmChanged(); } }
-    void setBoost(double v){ if (v!=m_boost){ m_boost=v; emit boostChanged(); } }
-    void setClt(double v){ if (v!=m_clt){ m_clt=v; emit cltChanged(); } }
-    void setIat(double v){ if (v!=m_iat){ m_iat=v; emit iatChanged(); } }
-    void setVbat(double v){ if (v!=m_vbat){ m_vbat=v; emit vbatChanged(); } }
-    void setAfr(double v){ if (v!=m_afr){ m_afr=v; emit afrChanged(); } }
-    void setGear(int v){ if (v!=m_gear){ m_gear=v; emit gearChanged(); } }
+    void setSpeed(double v){ if (v!=m_speed){ m_speed=v; changed(PSpeed); } }
+    void setRpm(double v){ if (v!=m_rpm){ m_rpm=v; changed(PRpm); } }
+    void setBoost(double v){ if (v!=m_boost){ m_boost=v; changed(PBoost); } }
+    void setClt(double v){ if (v!=m_clt){ m_clt=v; changed(PClt); } }
+    void setIat(double v){ if (v!=m_iat){ m_iat=v; changed(PIat); } }
+    void setVbat(double v){ if (v!=m_vbat){ m_vbat=v; changed(PVbat); } }
+    void setAfr(double v){ if (v!=m_afr){ m_afr=v; changed(PAfr); } }
+    void setGear(int v){ if (v!=m_gear){ m_gear=v; changed(PGear); } }
     void setDateTimeString(const QString& s){ if (s!=m_dt){ m_dt=s; emit dateTimeChanged(); } }
-    void setOdo(double v){ if (v!=m_odo){ m_odo=v; emit odoChanged(); } }
-    void setTrip(double v){ if (v!=m_trip){ m_trip=v; emit tripChanged(); } }
-    void setLeftSignal(bool v){ if (v!=m_leftSignal){ m_leftSignal=v; emit leftSignalChanged(); } }
-    void setRightSignal(bool v){ if (v!=m_rightSignal){ m_rightSignal=v; emit rightSignalChanged(); } }
-    void setHeadlightsOn(bool v){ if (v!=m_headlightsOn){ m_headlightsOn=v; emit headlightsOnChanged(); } }
-    void setCelOn(bool v){ if (v!=m_celOn){ m_celOn=v; emit celOnChanged(); } }
-    void setTcsOn(bool v){ if (v!=m_tcsOn){ m_tcsOn=v; emit tcsOnChanged(); } }
+    void setOdo(double v){ if (v!=m_odo){ m_odo=v; changed(POdo); } }
+    void setTrip(double v){ if (v!=m_trip){ m_trip=v; changed(PTrip); } }
+    void setLeftSignal(bool v){ if (v!=m_leftSignal){ m_leftSignal=v; changed(PLeftSignal); } }
+    void setRightSignal(bool v){ if (v!=m_rightSignal){ m_rightSignal=v; changed(PRightSignal); } }
+    void setHeadlightsOn(bool v){ if (v!=m_headlightsOn){ m_headlightsOn=v; changed(PHeadlightsOn); } }
+    void setCelOn(bool v){ if (v!=m_celOn){ m_celOn=v; changed(PCelOn); } }
+    void setTcsOn(bool v){ if (v!=m_tcsOn){ m_tcsOn=v; changed(PTcsOn); } }
     void setConnected(bool v){ if (m_connected != v) { m_connected = v; emit connectedChanged(); } }
+    void setCoalesceUpdates(bool on);
+    void flushPending(); // call once per frame (QQuickWindow::afterAnimating)
     void onSignal(const SignalUpdate &up);
+    void onBatch(const SignalBatch &batch);
 
     // Helper: update multiple sensor values at once (applies light smoothing)
     void applySample(double rpm, double mph, double boost, double clt,
@@ -140,8 +155,24 @@ signals:
     void gearRatioChanged(int gear, double ratio);
     void z60PopupChanged();
     void connectedChanged();
+    void coalesceUpdatesChanged();
+    void flushRequested(); // first value went dirty: schedule a frame
 
 private:
+    // Coalesced properties; order must match kNotify in dashmodel.cpp
+    enum Prop : quint8 {
+        PSpeed, PRpm, PBoost, PClt, PIat, PVbat, PAfr, PGear, POdo, PTrip,
+        PLeftSignal, PRightSignal, PHeadlightsOn, PCelOn, PTcsOn, PropCount
+    };
+    void changed(Prop p);
+
+    bool    m_coalesce = false;
+    quint32 m_dirty = 0;           // bit per Prop
+    quint64 m_notifyEmitted = 0;
+    quint64 m_notifySaved = 0;
+    quint64 m_flushes = 0;
+
+    double  m_baroKpa=101.325; // from Engine.Baro_kPa when the ECU sends it
     double  m_speed=0, m_rpm=0, m_boost=0, m_clt=0, m_iat=0, m_vbat=0, m_afr=0;
     int     m_gear=0;
     QString m_dt;
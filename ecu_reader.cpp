@@ -7,12 +7,11 @@
 #include <QOperatingSystemVersion>
 #include <QRegularExpression>
 #include <QUrl>
-#include <QXmlStreamReader>
 #include <QtBluetooth/QBluetoothSocket>
 #include <QtBluetooth/QBluetoothUuid>
 #include <QtMath>
+#include "transports/capture_recorder.h"
 
-static constexpr quint8 ID_CHAR = 0xA3;
 static const QBluetoothUuid
     SPP_UUID("{00001101-0000-1000-8000-00805F9B34FB}"); // RFCOMM SPP
 
@@ -55,7 +54,9 @@ void EcuReader::connectToDevice() {
     connect(m_socket.get(), &QBluetoothSocket::errorOccurred, this,
             &EcuReader::onErrorOccurred);
 
-    m_buf.clear();
+    m_decoder.reset();
+    m_decodeCalls = m_decodeTotalNs = m_decodeMaxNs = 0;
+    m_linkClock.start();
     m_socket->connectToService(m_address, SPP_UUID);
     emit info(QString("Connecting to %1 ...").arg(m_address.toString()));
   } else {
@@ -83,34 +84,14 @@ bool EcuReader::loadXmlMap(const QString &urlOrPath) {
     return false;
   }
 
-  m_chmap.clear();
-  QXmlStreamReader xr(&f);
-  while (!xr.atEnd()) {
-    xr.readNext();
-    if (xr.isStartElement() && xr.name() == QLatin1String("symbol")) {
-      auto a = xr.attributes();
-      if (!a.hasAttribute("channel"))
-        continue;
-      int ch = a.value("channel").toInt();
-      ChannelInfo ci;
-      ci.name = a.value("name").toString();
-      ci.storage = a.value("storage").toString();
-      ci.unit = a.value("unit").toString();
-      ci.divider = a.hasAttribute("divider")
-                       ? a.value("divider").toString().toDouble()
-                       : 1.0;
-      ci.offset = a.hasAttribute("offset")
-                      ? a.value("offset").toString().toDouble()
-                      : 0.0;
-      m_chmap.insert(ch, ci);
-    }
-  }
-  if (xr.hasError()) {
-    m_lastError = QString("XML parse error: %1").arg(xr.errorString());
+  QString err;
+  if (!m_channels.load(&f, &err)) {
+    m_lastError = QString("XML parse error: %1").arg(err);
     emit errorChanged(m_lastError);
     return false;
   }
-  emit info(QString("Loaded channel map (%1 symbols)").arg(m_chmap.size()));
+  emit info(QString("Loaded channel map (%1 symbols)")
+                .arg(m_channels.symbolCount()));
   return true;
 }
 
@@ -240,156 +221,131 @@ void EcuReader::onErrorOccurred(QBluetoothSocket::SocketError) {
 }
 
 void EcuReader::onReadyRead() {
-  m_buf += m_socket->readAll();
-  parseIncoming();
-}
-
-// ----- Frame decode -----
-void EcuReader::parseIncoming() {
-  int ch;
-  quint8 vh, vl, cs;
-  while (tryExtractFrame(ch, vh, vl, cs)) {
-    const ChannelInfo info =
-        m_chmap.value(ch, ChannelInfo{QString(), "word", 1.0, 0.0, QString()});
-    const qint32 raw = decodeRaw(info.storage, vh, vl);
-    const double val = scaleValue(info, raw);
-    applyChannel(ch, val);
-  }
-}
-
-bool EcuReader::tryExtractFrame(int &ch, quint8 &vh, quint8 &vl, quint8 &cs) {
-  // scan buffer for a 5-byte frame with ID_CHAR at index 1
-  for (int i = 0; i + 5 <= m_buf.size(); ++i) {
-    const uchar B0 = uchar(m_buf[i + 0]);
-    const uchar B1 = uchar(m_buf[i + 1]);
-    const uchar B2 = uchar(m_buf[i + 2]);
-    const uchar B3 = uchar(m_buf[i + 3]);
-    const uchar B4 = uchar(m_buf[i + 4]);
-    if (B1 != ID_CHAR)
-      continue;
-    const bool ok256 = checksumOk(B0, B2, B3, B4, 256);
-    const bool ok255 = !ok256 && checksumOk(B0, B2, B3, B4, 255);
-    if (!ok256 && !ok255)
-      continue;
-    ch = int(B0);
-    vh = B2;
-    vl = B3;
-    cs = B4;
-    m_buf.remove(0, i + 5);
-    return true;
+  // Read straight into a stack chunk; the decoder copies into its ring.
+  char chunk[1024];
+  QElapsedTimer t;
+  t.start();
+  qint64 n;
+  while ((n = m_socket->read(chunk, sizeof(chunk))) > 0) {
+    if (m_capture)
+      m_capture->recordBytes(chunk, n);
+    parseIncoming(chunk, n);
   }
-  // avoid unbounded growth on garbage
-  if (m_buf.size() > 4096)
-    m_buf.remove(0, m_buf.size() - 1024);
-  return false;
-}
-
-bool EcuReader::checksumOk(quint8 ch, quint8 vh, quint8 vl, quint8 cs,
-                           int mod) {
-  return ((int(ch) + int(ID_CHAR) + int(vh) + int(vl)) % mod) == cs;
+  const qint64 ns = t.nsecsElapsed();
+  ++m_decodeCalls;
+  m_decodeTotalNs += ns;
+  if (ns > m_decodeMaxNs)
+    m_decodeMaxNs = ns;
 }
 
-qint32 EcuReader::decodeRaw(const QString &storage, quint8 vh, quint8 vl) {
-  const QString s = storage.toLower();
-  if (s == "word" || s == "sword") {
-    quint16 u = (quint16(vh) << 8) | vl;
-    if (s == "sword")
-      return (u & 0x8000) ? (qint32(u) - 0x10000) : qint32(u);
-    return qint32(u);
-  }
-  qint32 u8 = vl; // 8-bit signals in low byte
-  if (s == "sbyte")
-    return (u8 & 0x80) ? (u8 - 0x100) : u8;
-  return u8; // ubyte/percent7
+QVariantMap EcuReader::decoderStats() const {
+  const auto &st = m_decoder.stats();
+  const double secs =
+      m_linkClock.isValid() ? m_linkClock.elapsed() / 1000.0 : 0.0;
+  QVariantMap m;
+  m.insert("bytesIn", st.bytesIn);
+  m.insert("frames", st.frames);
+  m.insert("frames255", st.frames255);
+  m.insert("checksumFailures", st.checksumFailures);
+  m.insert("resyncs", st.resyncs);
+  m.insert("bytesDiscarded", st.bytesDiscarded);
+  m.insert("synced",
+           m_decoder.state() == EcuMasterFrameDecoder::State::Synced);
+  m.insert("framesPerSec", secs > 0.0 ? st.frames / secs : 0.0);
+  m.insert("decodeAvgNs",
+           m_decodeCalls ? double(m_decodeTotalNs) / m_decodeCalls : 0.0);
+  m.insert("decodeMaxNs", m_decodeMaxNs);
+  return m;
 }
 
-double EcuReader::scaleValue(const ChannelInfo &info, qint32 raw) {
-  double v = raw;
-  if (info.divider != 0.0)
-    v /= info.divider;
-  v += info.offset;
-  return v;
+// ----- Frame decode -----
+void EcuReader::parseIncoming(const char *data, qsizetype len) {
+  m_decoder.feed(data, len, [this](const EcuMasterFrameDecoder::Frame &f) {
+    const auto &e = m_channels[f.ch];
+    if (e.slot != EcuMasterChannelMap::Slot::None)
+      applyChannel(e.slot, m_channels.decode(f.ch, f.vh, f.vl));
+  });
+  m_decoderMetrics.publish(m_decoder.stats());
 }
 
-void EcuReader::applyChannel(int ch, double v) {
-  const auto info = m_chmap.value(ch);
-  const QString nm = info.name.toLower();
-
-  // BARO / Atmospheric kPa
-  if (nm.contains("baro") || nm.contains("atmo")) {
+void EcuReader::applyChannel(EcuMasterChannelMap::Slot slot, double v) {
+  using Slot = EcuMasterChannelMap::Slot;
+  switch (slot) {
+  case Slot::Baro: {
     const int nv = int(qRound(v)); // v already scaled to kPa
     if (nv != m_baro) {
       m_baro = nv;
       emit baroChanged();
     }
+    break;
   }
-  // v1.218 key channels
-  switch (ch) {
-  case 1: {
+  case Slot::Rpm: {
     int nv = int(qRound(v));
     if (nv != m_rpm) {
       m_rpm = nv;
       emit rpmChanged();
     }
     break;
-  } // RPM word/1
-  case 2: {
+  }
+  case Slot::Map: {
     int nv = int(qRound(v));
     if (nv != m_map) {
       m_map = nv;
       emit mapChanged();
     }
     break;
-  } // MAP kPa word/1
-  case 3: {
+  }
+  case Slot::Tps: {
     int nv = int(qRound(v));
     if (nv != m_tps) {
       m_tps = nv;
       emit tpsChanged();
     }
     break;
-  } // TPS % ubyte/1
-  case 4: {
+  }
+  case Slot::Iat: {
     int nv = int(qRound(v));
     if (nv != m_iat) {
       m_iat = nv;
       emit iatChanged();
     }
     break;
-  } // IAT C sbyte/1
-  case 5: {
+  }
+  case Slot::Batt: {
     double nv = v;
     if (qFabs(nv - m_batt) > 0.01) {
       m_batt = nv;
       emit battChanged();
     }
     break;
-  } // Batt word/37 V
-  case 12: {
+  }
+  case Slot::Afr: {
     double nv = v;
     if (qFabs(nv - m_afr) > 0.01) {
       m_afr = nv;
       emit afrChanged();
     }
     break;
-  } // AFR ubyte/10
-  case 24: {
+  }
+  case Slot::Clt: {
     int nv = int(qRound(v));
     if (nv != m_clt) {
       m_clt = nv;
       emit cltChanged();
     }
     break;
-  } // CLT sword/1 C
-  case 27: {
+  }
+  case Slot::Lambda: {
     double nv = v;
     if (qFabs(nv - m_lambda) > 0.001) {
       m_lambda = nv;
       emit lambdaChanged();
     }
     break;
-  } // λ ubyte/128
-  default:
+  }
+  case Slot::Speed: // no legacy property; see EcuMasterClassicProtocol
+  case Slot::Gear:
+  case Slot::None:
     break;
   }
 }
@@ -9,16 +9,15 @@
 #include <QtBluetooth/QBluetoothDeviceDiscoveryAgent>
 #include <QtBluetooth/QBluetoothLocalDevice>
 #include <QVariant>
+#include <QVariantMap>
 #include <QHash>
 #include <QStringList>
+#include <QElapsedTimer>
+#include "protocols/ecumaster_channel_map.h"
+#include "protocols/ecumaster_decoder_metrics.h"
+#include "protocols/ecumaster_frame_decoder.h"
 
-struct ChannelInfo {
-    QString name;
-    QString storage;     // "word", "sword", "ubyte", "sbyte", "percent7"
-    double  divider = 1; // may be negative in XML (normalized comment)
-    double  offset  = 0;
-    QString unit;
-};
+class CaptureRecorder;
 
 class EcuReader : public QObject {
     Q_OBJECT
@@ -53,6 +52,12 @@ public:
     Q_INVOKABLE bool loadXmlMap(const QString& urlOrPath);
     Q_INVOKABLE QString connectionError() const { return m_lastError; }
 
+    // Decoder counters: frames, fps, resyncs, checksum failures, decode timing
+    Q_INVOKABLE QVariantMap decoderStats() const;
+
+    // Raw capture of every socket read (not owned; nullptr disables)
+    void setCaptureRecorder(CaptureRecorder* r) { m_capture = r; }
+
     // Discovery
     Q_INVOKABLE void startScan();
     Q_INVOKABLE void stopScan();
@@ -121,12 +126,8 @@ private slots:
     void onScanError(QBluetoothDeviceDiscoveryAgent::Error error);
 
 private:
-    void parseIncoming();
-    bool tryExtractFrame(int& ch, quint8& vh, quint8& vl, quint8& cs);
-    static bool checksumOk(quint8 ch, quint8 vh, quint8 vl, quint8 cs, int mod);
-    static qint32 decodeRaw(const QString& storage, quint8 vh, quint8 vl);
-    static double scaleValue(const ChannelInfo& info, qint32 raw);
-    void applyChannel(int ch, double value);
+    void parseIncoming(const char* data, qsizetype len);
+    void applyChannel(EcuMasterChannelMap::Slot slot, double value);
 
     // State
     int m_baro = 100;
@@ -143,9 +144,18 @@ private:
     QStringList m_devicesList;
     bool m_scanning = false;
 
-    // Decode buffer/map
-    QByteArray m_buf;
-    QHash<int, ChannelInfo> m_chmap;
+    // Decode ring/map
+    EcuMasterFrameDecoder m_decoder;
+    EcuMasterDecoderMetrics m_decoderMetrics{QStringLiteral("bt.ecumaster")};
+    EcuMasterChannelMap m_channels;
+
+    // Decode timing (per onReadyRead)
+    QElapsedTimer m_linkClock;
+    qint64 m_decodeCalls = 0;
+    qint64 m_decodeTotalNs = 0;
+    qint64 m_decodeMaxNs = 0;
+
+    CaptureRecorder* m_capture = nullptr;
 
     // Latest values
     int m_rpm=0, m_map=0, m_tps=0, m_iat=0, m_clt=0;
@@ -0,0 +1,14 @@
+#pragma once
+#include <QByteArray>
+#include <initializer_list>
+
+// One sampled-mode CSV log row: "<epoch ms>,<v0>,<v1>,...\n".
+// Appends to `row` (callers reuse one buffer per tick); values are written
+// with QByteArray::number's default %g formatting, so integral values keep
+// their plain integer form.
+inline void appendCsvRow(QByteArray &row, qint64 tMs, std::initializer_list<double> values) {
+    row.append(QByteArray::number(tMs));
+    for (double v : values)
+        row.append(',').append(QByteArray::number(v));
+    row.append('\n');
+}
@@ -0,0 +1,116 @@
+#include "raw_sample_logger.h"
+#include "core/signal_registry.h"
+#include <QThread>
+
+RawSampleLogger::RawSampleLogger(QObject *parent) : QObject(parent) {}
+
+RawSampleLogger::~RawSampleLogger() {
+    stop();
+}
+
+bool RawSampleLogger::start(const QString &path, QString *error) {
+    stop();
+
+    // Initial schema is the registry as of now; ids interned later are
+    // declared in the chunk that first uses them.
+    SignalRegistry &reg = SignalRegistry::instance();
+    QStringList names;
+    m_channelOf.fill(-1, reg.count());
+    for (int id = Sig::Invalid + 1; id < reg.count(); ++id) {
+        m_channelOf[id] = names.size();
+        names << reg.name(SignalId(id));
+    }
+    if (!m_writer.open(path, names, error))
+        return false;
+
+    {
+        QMutexLocker lk(&m_lock);
+        m_front.clear();
+        m_front.reserve(kSwapThreshold);
+        m_stop = false;
+    }
+    m_in = m_written = m_dropped = m_bytes = 0;
+    m_maxBacklog = 0;
+
+    m_thread = QThread::create([this] { run(); });
+    m_thread->setObjectName(QStringLiteral("KeyDash log writer"));
+    m_thread->start(QThread::LowPriority);
+    return true;
+}
+
+void RawSampleLogger::stop() {
+    if (!m_thread) return;
+    {
+        QMutexLocker lk(&m_lock);
+        m_stop = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+    m_writer.close();
+    m_bytes = m_writer.bytesWritten();
+}
+
+void RawSampleLogger::append(const SignalBatch &batch) {
+    if (!m_thread || batch.isEmpty()) return;
+    m_in.fetch_add(quint64(batch.size()), std::memory_order_relaxed);
+
+    QMutexLocker lk(&m_lock);
+    const int backlog = m_front.size() + batch.size();
+    if (backlog > kMaxPending) {
+        m_dropped.fetch_add(quint64(batch.size()), std::memory_order_relaxed);
+        return;
+    }
+    m_front.append(batch);
+    if (backlog > m_maxBacklog.load(std::memory_order_relaxed))
+        m_maxBacklog.store(backlog, std::memory_order_relaxed);
+    if (backlog >= kSwapThreshold)
+        m_wake.wakeOne();
+}
+
+void RawSampleLogger::run() {
+    SignalBatch back;
+    back.reserve(kSwapThreshold);
+    for (;;) {
+        bool stopping;
+        {
+            QMutexLocker lk(&m_lock);
+            if (!m_stop && m_front.size() < kSwapThreshold)
+                m_wake.wait(&m_lock, kMaxLatencyMs);
+            m_front.swap(back); // both keep their capacity
+            stopping = m_stop;
+        }
+        writeBatch(back);
+        back.clear();
+        if (stopping) break;
+    }
+}
+
+void RawSampleLogger::writeBatch(const SignalBatch &b) {
+    if (b.isEmpty()) return;
+    for (const SignalUpdate &u : b) {
+        if (u.id >= m_channelOf.size())
+            m_channelOf.resize(u.id + 1, -1);
+        int ch = m_channelOf[u.id];
+        if (ch < 0) {
+            const QString name = SignalRegistry::instance().name(u.id);
+            ch = m_writer.addChannel(name.isEmpty() ? QStringLiteral("sig%1").arg(u.id) : name);
+            m_channelOf[u.id] = ch;
+        }
+        m_writer.append(ch, u.t_ms, float(u.value));
+    }
+    m_written.fetch_add(quint64(b.size()), std::memory_order_relaxed);
+    m_bytes.store(m_writer.bytesWritten(), std::memory_order_relaxed);
+}
+
+QVariantMap RawSampleLogger::stats() const {
+    QVariantMap m;
+    m.insert("running", isRunning());
+    m.insert("samplesIn", m_in.load(std::memory_order_relaxed));
+    m.insert("samplesWritten", m_written.load(std::memory_order_relaxed));
+    m.insert("dropped", m_dropped.load(std::memory_order_relaxed));
+    m.insert("bytesWritten", m_bytes.load(std::memory_order_relaxed));
+    m.insert("maxBacklog", m_maxBacklog.load(std::memory_order_relaxed));
+    return m;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <QMutex>
+#include <QObject>
+#include <QVariantMap>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include "core/signal_types.h"
+#include "logging/session_log_writer.h"
+
+class QThread;
+
+// Full-rate logger: every decoded SignalUpdate, with its source timestamp,
+// goes to a .kdlog file. append() only copies the batch into the front
+// buffer under a short lock; a writer thread swaps the buffers and encodes
+// and writes the back one, so the GUI thread never touches the disk. When
+// the writer cannot keep up the front buffer is capped and whole batches are
+// dropped and counted instead of growing without bound.
+class RawSampleLogger : public QObject {
+    Q_OBJECT
+  public:
+    static constexpr int kSwapThreshold = 8192;    // samples, wakes the writer
+    static constexpr int kMaxPending    = 262144;  // samples, then drop
+    static constexpr int kMaxLatencyMs  = 250;     // writer wakes at least this often
+
+    explicit RawSampleLogger(QObject *parent=nullptr);
+    ~RawSampleLogger();
+
+    bool start(const QString &path, QString *error = nullptr);
+    void stop(); // drains what is queued, writes the index and closes
+    bool isRunning() const { return m_thread != nullptr; }
+
+           // samplesIn / samplesWritten / dropped / bytesWritten / maxBacklog
+    Q_INVOKABLE QVariantMap stats() const;
+
+  public slots:
+    void append(const SignalBatch &batch);
+
+  private:
+    void run();
+    void writeBatch(const SignalBatch &b);
+
+    QThread *m_thread{nullptr};
+    SessionLogWriter m_writer;     // writer thread only while running
+    QVector<int> m_channelOf;      // SignalId -> writer channel, -1 unknown
+
+    QMutex m_lock;
+    QWaitCondition m_wake;
+    SignalBatch m_front;           // guarded by m_lock
+    bool m_stop{false};            // guarded by m_lock
+
+    std::atomic<quint64> m_in{0};
+    std::atomic<quint64> m_written{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_bytes{0};
+    std::atomic<int> m_maxBacklog{0};
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <QByteArray>
+#include <QtEndian>
+#include <QtGlobal>
+#include <cstring>
+
+// KeyDash binary session log (.kdlog), all integers little-endian.
+//
+//   Header   magic "KDLOG01\0", u16 version, u16 flags, i64 createdMs,
+//            u16 channelCount, { u16 len, utf8 name } * channelCount
+//
+//   Chunk    u32 'KDCK', u32 payloadBytes (everything after this field),
+//            i64 t0Ms, i64 t1Ms,
+//            u16 newChannels, { u16 index, u16 len, utf8 name } * newChannels
+//            u16 columnCount, column * columnCount,
+//            footer: { u16 channel, f32 min, f32 max } * columnCount
+//
+//   Column   u16 channel, u8 flags, u32 count,
+//            [u32 tsBytes, zigzag-varint deltas (first one relative to t0)]
+//                                          unless ColSharedTs
+//            f32 values * count            (one f32 if ColConstValue)
+//
+//   Index    u32 'KDIX', u16 channelCount, { u16 len, utf8 name } * count
+//            (final schema), u32 chunkCount, { u64 offset, i64 t0, i64 t1 } * n
+//   Tail     u64 indexOffset, u32 'KDIX'
+//
+// A file without a tail (power cut) is still readable by walking the chunks
+// from the end of the header.
+namespace KdLog {
+
+constexpr char    kMagic[8]     = {'K', 'D', 'L', 'O', 'G', '0', '1', '\0'};
+constexpr quint16 kVersion      = 1;
+constexpr quint32 kChunkMagic   = 0x4B43444B; // 'KDCK'
+constexpr quint32 kIndexMagic   = 0x5849444B; // 'KDIX'
+constexpr int     kTailBytes    = 12;
+constexpr int     kFooterEntry  = 10;         // u16 + f32 + f32
+
+enum ColumnFlag : quint8 {
+    ColSharedTs   = 0x01, // timestamps identical to the previous column's
+    ColConstValue = 0x02, // every sample has the same value
+};
+
+template <typename T> inline void put(QByteArray &out, T v) {
+    const T le = qToLittleEndian(v);
+    out.append(reinterpret_cast<const char *>(&le), sizeof(T));
+}
+
+inline void putF32(QByteArray &out, float v) {
+    quint32 bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    put<quint32>(out, bits);
+}
+
+inline void putVarint(QByteArray &out, qint64 v) {
+    quint64 z = (quint64(v) << 1) ^ quint64(v >> 63); // zigzag
+    while (z >= 0x80) {
+        out.append(char(quint8(z) | 0x80));
+        z >>= 7;
+    }
+    out.append(char(z));
+}
+
+// Bounds-checked little-endian cursor over a mapped file.
+struct Cursor {
+    const uchar *p;
+    const uchar *end;
+
+    bool has(qint64 n) const { return n >= 0 && end - p >= n; }
+
+    template <typename T> bool get(T &v) {
+        if (!has(sizeof(T))) return false;
+        v = qFromLittleEndian<T>(p);
+        p += sizeof(T);
+        return true;
+    }
+
+    bool getF32(float &v) {
+        quint32 bits;
+        if (!get(bits)) return false;
+        std::memcpy(&v, &bits, sizeof v);
+        return true;
+    }
+
+    bool getVarint(qint64 &v) {
+        quint64 z = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p == end) return false;
+            const quint8 b = *p++;
+            z |= quint64(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                v = qint64(z >> 1) ^ -qint64(z & 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool skip(qint64 n) {
+        if (!has(n)) return false;
+        p += n;
+        return true;
+    }
+};
+
+} // namespace KdLog
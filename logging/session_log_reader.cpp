@@ -0,0 +1,255 @@
+#include "session_log_reader.h"
+#include "session_log_format.h"
+#include <algorithm>
+
+using namespace KdLog;
+
+namespace {
+
+bool getName(Cursor &c, QString *out) {
+    quint16 len;
+    if (!c.get(len) || !c.has(len)) return false;
+    *out = QString::fromUtf8(reinterpret_cast<const char *>(c.p), len);
+    c.p += len;
+    return true;
+}
+
+// Chunk body bounds and the start of its column section.
+struct ChunkView {
+    Cursor  cols;         // positioned at the first column block
+    const uchar *footer;  // columnCount * kFooterEntry bytes
+    quint16 columnCount;
+};
+
+bool openChunk(const uchar *data, qint64 size, qint64 offset, ChunkView *v) {
+    Cursor c{data + offset, data + size};
+    quint32 magic, payload;
+    if (!c.get(magic) || magic != kChunkMagic || !c.get(payload) || !c.has(payload))
+        return false;
+    const uchar *end = c.p + payload;
+    c.end = end;
+
+    quint16 newChannels;
+    if (!c.skip(16) || !c.get(newChannels)) return false;
+    for (int i = 0; i < newChannels; ++i) {
+        quint16 len;
+        if (!c.skip(2) || !c.get(len) || !c.skip(len)) return false;
+    }
+    if (!c.get(v->columnCount)) return false;
+    const qint64 footerBytes = qint64(v->columnCount) * kFooterEntry;
+    if (end - c.p < footerBytes) return false;
+    v->footer = end - footerBytes;
+    v->cols = Cursor{c.p, v->footer};
+    return true;
+}
+
+} // namespace
+
+bool SessionLogReader::open(const QString &path, QString *error) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error) *error = m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        if (error) *error = QStringLiteral("cannot map %1").arg(path);
+        close();
+        return false;
+    }
+
+    Cursor c{m_data, m_data + m_size};
+    quint16 version, flags, count;
+    if (!c.has(sizeof kMagic) || std::memcmp(c.p, kMagic, sizeof kMagic) != 0) {
+        if (error) *error = QStringLiteral("not a KeyDash session log");
+        close();
+        return false;
+    }
+    c.p += sizeof kMagic;
+    if (!c.get(version) || version > kVersion || !c.get(flags) || !c.get(m_createdMs) || !c.get(count)) {
+        if (error) *error = QStringLiteral("unsupported or truncated header");
+        close();
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        QString name;
+        if (!getName(c, &name)) {
+            if (error) *error = QStringLiteral("truncated channel table");
+            close();
+            return false;
+        }
+        m_channels.append(name);
+    }
+    m_headerEnd = c.p - m_data;
+
+    if (!loadIndex()) {
+        m_recovered = true;
+        scanChunks(m_headerEnd);
+    }
+    return true;
+}
+
+void SessionLogReader::close() {
+    if (m_data) m_file.unmap(const_cast<uchar *>(m_data));
+    m_data = nullptr;
+    m_size = 0;
+    m_file.close();
+    m_channels.clear();
+    m_chunks.clear();
+    m_recovered = false;
+}
+
+qint64 SessionLogReader::endMs() const {
+    qint64 t = 0;
+    for (const ChunkInfo &ci : m_chunks)
+        t = qMax(t, ci.t1);
+    return t;
+}
+
+bool SessionLogReader::loadIndex() {
+    if (m_size < m_headerEnd + kTailBytes) return false;
+    Cursor tail{m_data + m_size - kTailBytes, m_data + m_size};
+    quint64 indexOffset;
+    quint32 magic;
+    tail.get(indexOffset);
+    tail.get(magic);
+    if (magic != kIndexMagic || indexOffset < quint64(m_headerEnd) ||
+        indexOffset > quint64(m_size - kTailBytes))
+        return false;
+
+    Cursor c{m_data + indexOffset, m_data + m_size - kTailBytes};
+    quint16 count;
+    quint32 chunks;
+    if (!c.get(magic) || magic != kIndexMagic || !c.get(count)) return false;
+    QStringList names;
+    for (int i = 0; i < count; ++i) {
+        QString n;
+        if (!getName(c, &n)) return false;
+        names.append(n);
+    }
+    if (!c.get(chunks) || !c.has(qint64(chunks) * 24)) return false;
+
+    QVector<ChunkInfo> list;
+    list.reserve(chunks);
+    for (quint32 i = 0; i < chunks; ++i) {
+        quint64 off;
+        ChunkInfo ci;
+        c.get(off);
+        c.get(ci.t0);
+        c.get(ci.t1);
+        if (off >= indexOffset) return false;
+        ci.offset = qint64(off);
+        list.append(ci);
+    }
+    m_channels = names;
+    m_chunks = list;
+    return true;
+}
+
+bool SessionLogReader::scanChunks(qint64 from) {
+    Cursor c{m_data + from, m_data + m_size};
+    while (c.has(8)) {
+        const qint64 offset = c.p - m_data;
+        quint32 magic, payload;
+        c.get(magic);
+        c.get(payload);
+        if (magic != kChunkMagic || !c.has(payload)) break; // torn tail
+        Cursor body{c.p, c.p + payload};
+        ChunkInfo ci{offset, 0, 0};
+        quint16 newChannels;
+        body.get(ci.t0);
+        body.get(ci.t1);
+        body.get(newChannels);
+        for (int i = 0; i < newChannels; ++i) {
+            quint16 idx;
+            QString name;
+            if (!body.get(idx) || !getName(body, &name)) break;
+            while (m_channels.size() <= idx) m_channels.append(QString());
+            m_channels[idx] = name;
+        }
+        m_chunks.append(ci);
+        c.p += payload;
+    }
+    return !m_chunks.isEmpty();
+}
+
+int SessionLogReader::readColumn(int chunk, int channel, QVector<qint64> *ts, QVector<float> *vals) const {
+    if (!m_data || chunk < 0 || chunk >= m_chunks.size()) return 0;
+    const ChunkInfo &ci = m_chunks.at(chunk);
+    ChunkView v;
+    if (!openChunk(m_data, m_size, ci.offset, &v)) return 0;
+
+    Cursor &c = v.cols;
+    Cursor lastTs{nullptr, nullptr};
+    for (int i = 0; i < v.columnCount; ++i) {
+        quint16 ch;
+        quint8 flags;
+        quint32 count;
+        if (!c.get(ch) || !c.get(flags) || !c.get(count)) return 0;
+        if (!(flags & ColSharedTs)) {
+            quint32 tsBytes;
+            if (!c.get(tsBytes) || !c.has(tsBytes)) return 0;
+            lastTs = Cursor{c.p, c.p + tsBytes};
+            c.p += tsBytes;
+        }
+        const qint64 valueBytes = (flags & ColConstValue) ? 4 : qint64(count) * 4;
+        if (ch != channel) {
+            if (!c.skip(valueBytes)) return 0;
+            continue;
+        }
+        // Every delta is at least one varint byte: bounds count before it
+        // sizes anything (a constant column's values don't)
+        if (!lastTs.p || !lastTs.has(count) || !c.has(valueBytes)) return 0;
+
+        const int base = ts->size();
+        ts->resize(base + int(count));
+        vals->resize(base + int(count));
+        qint64 t = ci.t0;
+        for (quint32 k = 0; k < count; ++k) {
+            qint64 d;
+            if (!lastTs.getVarint(d)) {
+                ts->resize(base);
+                vals->resize(base);
+                return 0;
+            }
+            t += d;
+            (*ts)[base + int(k)] = t;
+        }
+        if (flags & ColConstValue) {
+            float cv;
+            c.getF32(cv);
+            std::fill(vals->begin() + base, vals->end(), cv);
+        } else {
+            for (quint32 k = 0; k < count; ++k)
+                c.getF32((*vals)[base + int(k)]);
+        }
+        return int(count);
+    }
+    return 0;
+}
+
+int SessionLogReader::readChannel(int channel, QVector<qint64> *ts, QVector<float> *vals) const {
+    int n = 0;
+    for (int i = 0; i < m_chunks.size(); ++i)
+        n += readColumn(i, channel, ts, vals);
+    return n;
+}
+
+bool SessionLogReader::columnRange(int chunk, int channel, float *min, float *max) const {
+    if (!m_data || chunk < 0 || chunk >= m_chunks.size()) return false;
+    ChunkView v;
+    if (!openChunk(m_data, m_size, m_chunks.at(chunk).offset, &v)) return false;
+    Cursor f{v.footer, v.footer + qint64(v.columnCount) * kFooterEntry};
+    for (int i = 0; i < v.columnCount; ++i) {
+        quint16 ch;
+        f.get(ch);
+        if (ch != channel) {
+            f.skip(8);
+            continue;
+        }
+        return f.getF32(*min) && f.getF32(*max);
+    }
+    return false;
+}
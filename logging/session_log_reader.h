@@ -0,0 +1,57 @@
+#pragma once
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+
+// Memory-mapped reader for .kdlog sessions (see session_log_format.h).
+//
+// open() maps the file and reads only the header and the trailing chunk
+// index, so opening is independent of the log length; column data is
+// decoded on demand. Files without an index (the writer never closed) are
+// recovered by walking the chunk headers.
+class SessionLogReader {
+  public:
+    struct ChunkInfo {
+        qint64 offset;
+        qint64 t0;
+        qint64 t1;
+    };
+
+    SessionLogReader() = default;
+    ~SessionLogReader() { close(); }
+
+    bool open(const QString &path, QString *error = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    bool recovered() const { return m_recovered; }
+
+    qint64      createdMs() const { return m_createdMs; }
+    QStringList channels() const { return m_channels; }
+    int         channelIndex(const QString &name) const { return m_channels.indexOf(name); }
+
+    int              chunkCount() const { return m_chunks.size(); }
+    const ChunkInfo &chunk(int i) const { return m_chunks.at(i); }
+    qint64           startMs() const { return m_chunks.isEmpty() ? 0 : m_chunks.first().t0; }
+    qint64           endMs() const;
+
+    // Append one channel's samples from one chunk / the whole log.
+    // Returns the number of samples appended.
+    int readColumn(int chunk, int channel, QVector<qint64> *ts, QVector<float> *vals) const;
+    int readChannel(int channel, QVector<qint64> *ts, QVector<float> *vals) const;
+
+    // Per-chunk min/max from the chunk footer, without decoding the column.
+    bool columnRange(int chunk, int channel, float *min, float *max) const;
+
+  private:
+    bool loadIndex();
+    bool scanChunks(qint64 from);
+
+    QFile              m_file;
+    const uchar       *m_data = nullptr;
+    qint64             m_size = 0;
+    qint64             m_headerEnd = 0;
+    qint64             m_createdMs = 0;
+    bool               m_recovered = false;
+    QStringList        m_channels;
+    QVector<ChunkInfo> m_chunks;
+};
@@ -0,0 +1,204 @@
+#include "session_log_writer.h"
+#include "session_log_format.h"
+#include <QDateTime>
+#include <algorithm>
+
+using namespace KdLog;
+
+namespace {
+
+void putName(QByteArray &out, const QString &name) {
+    QByteArray utf8 = name.toUtf8();
+    if (utf8.size() > 0xFFFF) {
+        // Cut before a lead byte, never inside a multi-byte sequence
+        qsizetype n = 0xFFFF;
+        while (n > 0 && (uchar(utf8.at(n)) & 0xC0) == 0x80) --n;
+        utf8.truncate(n);
+    }
+    put<quint16>(out, quint16(utf8.size()));
+    out.append(utf8);
+}
+
+} // namespace
+
+SessionLogWriter::SessionLogWriter(int chunkSamples)
+    : m_chunkSamples(qMax(256, chunkSamples)) {}
+
+SessionLogWriter::~SessionLogWriter() {
+    close();
+}
+
+bool SessionLogWriter::open(const QString &path, const QStringList &channels, QString *error) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = m_file.errorString();
+        return false;
+    }
+
+    m_names = channels;
+    m_declared = channels.size();
+    m_cols = QVector<Column>(channels.size());
+    m_index.clear();
+    m_pending = 0;
+    m_samplesWritten = 0;
+    m_bytesWritten = 0;
+
+    QByteArray hdr;
+    hdr.append(kMagic, sizeof kMagic);
+    put<quint16>(hdr, kVersion);
+    put<quint16>(hdr, 0);
+    put<qint64>(hdr, QDateTime::currentMSecsSinceEpoch());
+    put<quint16>(hdr, quint16(m_names.size()));
+    for (const QString &n : std::as_const(m_names))
+        putName(hdr, n);
+    if (!writeOut(hdr)) {
+        if (error) *error = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+int SessionLogWriter::addChannel(const QString &name) {
+    const int idx = m_names.indexOf(name);
+    if (idx >= 0) return idx;
+    if (m_names.size() >= 0xFFFF) return -1;
+    m_names.append(name);
+    m_cols.append(Column{});
+    return m_names.size() - 1;
+}
+
+void SessionLogWriter::append(int channel, qint64 tMs, float value) {
+    if (channel < 0 || channel >= m_cols.size() || !isOpen()) return;
+    Column &c = m_cols[channel];
+    if (c.ts.isEmpty()) {
+        c.min = c.max = value;
+    } else {
+        c.min = qMin(c.min, value);
+        c.max = qMax(c.max, value);
+    }
+    c.ts.append(tMs);
+    c.vals.append(value);
+
+    if (m_pending == 0) {
+        m_t0 = m_t1 = tMs;
+    } else {
+        m_t0 = qMin(m_t0, tMs);
+        m_t1 = qMax(m_t1, tMs);
+    }
+    if (++m_pending >= m_chunkSamples || m_t1 - m_t0 >= kMaxChunkSpanMs)
+        flushChunk();
+}
+
+bool SessionLogWriter::flushChunk() {
+    if (!isOpen()) return false;
+    if (m_pending == 0 && m_declared == m_names.size()) return true;
+
+    m_buf.resize(0);
+    put<quint32>(m_buf, kChunkMagic);
+    put<quint32>(m_buf, 0); // payload size, patched below
+    put<qint64>(m_buf, m_t0);
+    put<qint64>(m_buf, m_t1);
+
+    put<quint16>(m_buf, quint16(m_names.size() - m_declared));
+    for (int i = m_declared; i < m_names.size(); ++i) {
+        put<quint16>(m_buf, quint16(i));
+        putName(m_buf, m_names.at(i));
+    }
+    m_declared = m_names.size();
+
+    quint16 columns = 0;
+    for (const Column &c : std::as_const(m_cols))
+        columns += c.ts.isEmpty() ? 0 : 1;
+    put<quint16>(m_buf, columns);
+
+    const Column *prev = nullptr;
+    for (int ch = 0; ch < m_cols.size(); ++ch) {
+        const Column &c = m_cols.at(ch);
+        if (c.ts.isEmpty()) continue;
+
+        quint8 flags = 0;
+        if (prev && prev->ts == c.ts) flags |= ColSharedTs;
+        if (std::all_of(c.vals.cbegin(), c.vals.cend(), [&](float v) { return v == c.vals.first(); }))
+            flags |= ColConstValue;
+
+        put<quint16>(m_buf, quint16(ch));
+        put<quint8>(m_buf, flags);
+        put<quint32>(m_buf, quint32(c.ts.size()));
+        if (!(flags & ColSharedTs)) {
+            const qsizetype lenAt = m_buf.size();
+            put<quint32>(m_buf, 0);
+            qint64 last = m_t0;
+            for (qint64 t : c.ts) {
+                putVarint(m_buf, t - last);
+                last = t;
+            }
+            const quint32 tsBytes = qToLittleEndian(quint32(m_buf.size() - lenAt - 4));
+            std::memcpy(m_buf.data() + lenAt, &tsBytes, 4);
+        }
+        if (flags & ColConstValue) {
+            putF32(m_buf, c.vals.first());
+        } else {
+            for (float v : c.vals)
+                putF32(m_buf, v);
+        }
+        prev = &c;
+    }
+
+    for (int ch = 0; ch < m_cols.size(); ++ch) {
+        const Column &c = m_cols.at(ch);
+        if (c.ts.isEmpty()) continue;
+        put<quint16>(m_buf, quint16(ch));
+        putF32(m_buf, c.min);
+        putF32(m_buf, c.max);
+    }
+
+    const quint32 payload = qToLittleEndian(quint32(m_buf.size() - 8));
+    std::memcpy(m_buf.data() + 4, &payload, 4);
+
+    const qint64 offset = m_file.pos();
+    if (!writeOut(m_buf) || !m_file.flush()) return false;
+    m_index.append({offset, m_t0, m_t1});
+    m_samplesWritten += quint64(m_pending);
+
+    for (Column &c : m_cols) {
+        c.ts.resize(0);   // keeps capacity for the next chunk
+        c.vals.resize(0);
+    }
+    m_pending = 0;
+    return true;
+}
+
+bool SessionLogWriter::close() {
+    if (!isOpen()) return true;
+    bool ok = flushChunk();
+
+    QByteArray idx;
+    const qint64 indexOffset = m_file.pos();
+    put<quint32>(idx, kIndexMagic);
+    put<quint16>(idx, quint16(m_names.size()));
+    for (const QString &n : std::as_const(m_names))
+        putName(idx, n);
+    put<quint32>(idx, quint32(m_index.size()));
+    for (const IndexEntry &e : std::as_const(m_index)) {
+        put<quint64>(idx, quint64(e.offset));
+        put<qint64>(idx, e.t0);
+        put<qint64>(idx, e.t1);
+    }
+    put<quint64>(idx, quint64(indexOffset));
+    put<quint32>(idx, kIndexMagic);
+    ok = writeOut(idx) && ok;
+
+    m_file.close();
+    return ok;
+}
+
+bool SessionLogWriter::writeOut(const QByteArray &data) {
+    if (m_file.write(data) != data.size()) {
+        qWarning("SessionLogWriter: write failed: %s", qPrintable(m_file.errorString()));
+        return false;
+    }
+    m_bytesWritten += quint64(data.size());
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+
+// Writes a .kdlog session (see session_log_format.h).
+//
+// Samples are buffered per channel and written as one chunk of column
+// blocks every `chunkSamples` samples (or kMaxChunkSpanMs of data, so a
+// power cut loses at most a few seconds), so the file sees a few large
+// writes instead of one small write per row. Not thread-safe: own it from
+// one thread.
+class SessionLogWriter {
+  public:
+    static constexpr int    kDefaultChunkSamples = 16384;
+    static constexpr qint64 kMaxChunkSpanMs      = 5000;
+
+    explicit SessionLogWriter(int chunkSamples = kDefaultChunkSamples);
+    ~SessionLogWriter();
+
+    bool open(const QString &path, const QStringList &channels, QString *error = nullptr);
+    bool isOpen() const { return m_file.isOpen(); }
+    QString fileName() const { return m_file.fileName(); }
+    bool close(); // flushes the last chunk and writes the index
+
+    int  channelCount() const { return m_names.size(); }
+    int  addChannel(const QString &name); // declared in the next chunk
+    void append(int channel, qint64 tMs, float value);
+    bool flushChunk();
+
+    quint64 samplesWritten() const { return m_samplesWritten; }
+    quint64 bytesWritten() const { return m_bytesWritten; }
+    int     chunkCount() const { return m_index.size(); }
+
+  private:
+    struct Column {
+        QVector<qint64> ts;
+        QVector<float>  vals;
+        float min = 0.0f;
+        float max = 0.0f;
+    };
+    struct IndexEntry {
+        qint64 offset;
+        qint64 t0;
+        qint64 t1;
+    };
+
+    bool writeOut(const QByteArray &data);
+
+    QFile               m_file;
+    QStringList         m_names;
+    int                 m_declared = 0;  // channels already in the file
+    QVector<Column>     m_cols;
+    QVector<IndexEntry> m_index;
+    QByteArray          m_buf;           // chunk staging, reused
+    int                 m_chunkSamples;
+    int                 m_pending = 0;
+    qint64              m_t0 = 0;
+    qint64              m_t1 = 0;
+    quint64             m_samplesWritten = 0;
+    quint64             m_bytesWritten = 0;
+};
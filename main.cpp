@@ -6,6 +6,8 @@
 #include <QLockFile>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQmlEngine>
+#include <QQuickWindow>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QTimer>
@@ -13,12 +15,23 @@
 #include <QElapsedTimer>
 
 #include <algorithm>
+#include <iterator>
 
 #include "FileReader.h"
 #include "crashlog.h"
 #include "dashmodel.h"
 #include "ecu_reader.h"
 #include "controllers/connection_controller.h"
+#include "core/signal_history.h"
+#include "core/signal_history_model.h"
+#include "core/pipeline_metrics_model.h"
+#include "logging/csv_row.h"
+#include "logging/raw_sample_logger.h"
+#include "logging/session_log_writer.h"
+#include "render/tach_sweep_item.h"
+#include "render/tinted_image_provider.h"
+#include "replay/log_replay_engine.h"
+#include "transports/capture_recorder.h"
 
 #ifdef HAVE_SERIALPORT
 #include "serialworker.h"
@@ -68,13 +81,36 @@ int main(int argc, char *argv[]) {
   // --- Models/IO ---
   DashModel dash;
   dash.loadVehicleConfig();
+
+  // Raw transport capture (.kdcap / candump), replayable via "replay".
+  // Declared before the transports' owners so it outlives their taps.
+  // KeyDash/captureEnabled: start recording at launch
+  // KeyDash/captureFormat:  "kdcap" (default) or "candump" (CAN only)
+  // KeyDash/captureDir:     empty → <app data>/captures
+  CaptureRecorder capture;
+  capture.setOutputDir(settings.value("KeyDash/captureDir").toString());
+
   ConnectionController conn;
+  conn.setCaptureRecorder(&capture);
+  conn.setDbcPath(settings.value("KeyDash/dbcPath").toString());
+  QObject::connect(&conn, &ConnectionController::dbcPathChanged, &app,
+                   [&]() { settings.setValue("KeyDash/dbcPath", conn.dbcPath()); });
+
+  QObject::connect(&conn, &ConnectionController::batch,
+                   &dash, &DashModel::onBatch);
 
-  QObject::connect(&conn, &ConnectionController::sig,
-                   &dash, &DashModel::onSignal);
+  // Recent per-signal history for sparklines / peak-hold
+  SignalHistory history;
+  history.setBudgetKb(settings.value("KeyDash/historyBudgetKb", 1024).toInt());
+  QObject::connect(&conn, &ConnectionController::batch,
+                   &history, &SignalHistory::onBatch);
 
   EcuReader ecu;
   ecu.loadXmlMap("qrc:/proto/version1_218.xml");
+  ecu.setCaptureRecorder(&capture);
+  if (settings.value("KeyDash/captureEnabled", false).toBool())
+    capture.startSession(
+        settings.value("KeyDash/captureFormat", "kdcap").toString());
 
   QElapsedTimer lastTraffic;
   lastTraffic.invalidate();     // not valid until we see first packet
@@ -183,9 +219,9 @@ int main(int argc, char *argv[]) {
           connectLegacyBridge(false);   // disable legacy when Demo/others are active
       }
   });
-  // Heartbeat: any incoming normalized signal = fresh traffic
-  QObject::connect(&conn, &ConnectionController::sig, &app,
-                   [&](const SignalUpdate&) {
+  // Heartbeat: any incoming batch of normalized signals = fresh traffic
+  QObject::connect(&conn, &ConnectionController::batch, &app,
+                   [&](const SignalBatch&) {
                        lastTraffic.restart();
                        dash.setConnected(true);
                    });
@@ -268,24 +304,46 @@ int main(int argc, char *argv[]) {
       });
 
   // ==========================================================
-  //                   CSV Session logging
+  //                     Session logging
   // ==========================================================
+  // KeyDash/logMode:   "sampled" (default): DashModel values at logHz
+  //                   "raw": every decoded sample at full rate (.kdlog)
+  // KeyDash/logFormat: "csv" (default) or "kdlog" for sampled mode
+  RawSampleLogger rawLog;
+  QObject::connect(&conn, &ConnectionController::batch,
+                   &rawLog, &RawSampleLogger::append);
   QFile logFile;
+  SessionLogWriter kdlog;
+  bool logBinary = false;
   QTimer logTimer;
+  const QStringList logColumns = {"rpm", "speed", "useMph", "boost", "clt", "iat",
+                                  "vbat", "afr", "gear", "map", "baro"};
 
   auto writeHeader = [&](QFile &f) {
     static const QByteArray hdr =
         "ts_ms,rpm,speed,useMph,boost,clt,iat,vbat,afr,gear,map,baro\n";
     f.write(hdr);
   };
-  auto openLogFile = [&]() -> bool {
+  auto logPath = [&](const char *ext) {
     QString dir = settings.value("KeyDash/logDir").toString();
     if (dir.isEmpty())
       dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir().mkpath(dir);
-    const QString path =
-        dir + QDir::separator() +
-        QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + ".csv";
+    return dir + QDir::separator() +
+           QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + ext;
+  };
+  auto openLogFile = [&]() -> bool {
+    logBinary = settings.value("KeyDash/logFormat", "csv").toString() ==
+                QLatin1String("kdlog");
+    const QString path = logPath(logBinary ? ".kdlog" : ".csv");
+    if (logBinary) {
+      QString err;
+      if (!kdlog.open(path, logColumns, &err)) {
+        qWarning("Could not open log file: %s", qPrintable(err));
+        return false;
+      }
+      return true;
+    }
     logFile.setFileName(path);
     if (!logFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
       qWarning("Could not open log file");
@@ -297,19 +355,31 @@ int main(int argc, char *argv[]) {
   auto updateLogTimer = [&]() {
     logTimer.stop();
     const bool on = settings.value("KeyDash/logEnabled", false).toBool();
+    const bool raw = settings.value("KeyDash/logMode", "sampled").toString() ==
+                     QLatin1String("raw");
     int hz = std::clamp(settings.value("KeyDash/logHz", 10).toInt(), 1, 50);
-    if (!on) {
+    if (!on || raw) {
       if (logFile.isOpen())
         logFile.close();
+      kdlog.close();
+    }
+    if (!on || !raw)
+      rawLog.stop();
+    if (!on)
+      return;
+    if (raw) {
+      QString err;
+      if (!rawLog.isRunning() && !rawLog.start(logPath(".kdlog"), &err))
+        qWarning("Could not open log file: %s", qPrintable(err));
       return;
     }
-    if (!logFile.isOpen())
+    if (!logFile.isOpen() && !kdlog.isOpen())
       if (!openLogFile())
         return;
     logTimer.start(1000 / hz);
   };
   QObject::connect(&logTimer, &QTimer::timeout, &app, [&]() {
-    if (!logFile.isOpen())
+    if (!logFile.isOpen() && !kdlog.isOpen())
       return;
     double baroKpa = settings.value("KeyDash/baroKpa", 101.3).toDouble();
     int propIdx = ecu.metaObject()->indexOfProperty("baro");
@@ -319,20 +389,23 @@ int main(int argc, char *argv[]) {
         baroKpa = v.toDouble();
     }
     const qint64 t = QDateTime::currentMSecsSinceEpoch();
+    if (logBinary) {
+      const float v[] = {float(dash.rpm()),   float(dash.speed()),
+                         dash.useMph() ? 1.0f : 0.0f,
+                         float(dash.boost()), float(dash.clt()),
+                         float(dash.iat()),   float(dash.vbat()),
+                         float(dash.afr()),   float(dash.gear()),
+                         float(ecu.map()),    float(baroKpa)};
+      for (int i = 0; i < int(std::size(v)); ++i)
+        kdlog.append(i, t, v[i]);
+      return;
+    }
     QByteArray row;
     row.reserve(200);
-    row.append(QByteArray::number(t)).append(',');
-    row.append(QByteArray::number(dash.rpm())).append(',');
-    row.append(QByteArray::number(dash.speed())).append(',');
-    row.append(dash.useMph() ? "1," : "0,");
-    row.append(QByteArray::number(dash.boost())).append(',');
-    row.append(QByteArray::number(dash.clt())).append(',');
-    row.append(QByteArray::number(dash.iat())).append(',');
-    row.append(QByteArray::number(dash.vbat())).append(',');
-    row.append(QByteArray::number(dash.afr())).append(',');
-    row.append(QByteArray::number(dash.gear())).append(',');
-    row.append(QByteArray::number(ecu.map())).append(',');
-    row.append(QByteArray::number(baroKpa)).append('\n');
+    appendCsvRow(row, t,
+                 {double(dash.rpm()), dash.speed(), dash.useMph() ? 1.0 : 0.0,
+                  dash.boost(), dash.clt(), dash.iat(), dash.vbat(), dash.afr(),
+                  double(dash.gear()), double(ecu.map()), baroKpa});
     logFile.write(row);
   });
   QTimer prefsPoll;
@@ -348,6 +421,10 @@ int main(int argc, char *argv[]) {
   // ==========================================================
   QQmlApplicationEngine engine;
 
+  qmlRegisterType<LogReplayEngine>("KeyDash.Replay", 1, 0, "LogReplayEngine");
+  qmlRegisterType<SignalHistoryModel>("KeyDash.History", 1, 0, "SignalHistoryModel");
+  qmlRegisterType<TachSweepItem>("KeyDash.Render", 1, 0, "TachSweep");
+
   // DO NOT add qrc:/ as an import path.
   // engine.addImportPath("qrc:/");  // keep this commented out
 
@@ -358,6 +435,23 @@ int main(int argc, char *argv[]) {
   engine.rootContext()->setContextProperty("dash", &dash);
   engine.rootContext()->setContextProperty("ecu",  &ecu);
   engine.rootContext()->setContextProperty("connCtrl", &conn);
+  engine.rootContext()->setContextProperty("rawLog", &rawLog);
+  engine.rootContext()->setContextProperty("capture", &capture);
+  engine.rootContext()->setContextProperty("history", &history);
+  engine.rootContext()->setContextProperty("latency", conn.latency());
+
+  // Pipeline health counters (ServicePage) + periodic JSON snapshot
+  PipelineMetricsModel pipelineMetrics;
+  pipelineMetrics.setSnapshot(
+      QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) +
+          "/metrics/pipeline_snapshot.json",
+      settings.value("KeyDash/metricsSnapshotSec", 30).toInt());
+  engine.rootContext()->setContextProperty("pipelineMetrics", &pipelineMetrics);
+
+  // Tinted frame/tach/icon textures (engine takes ownership)
+  auto *tinted = new TintedImageProvider;
+  engine.addImageProvider(TintedImageProvider::kId, tinted);
+  engine.rootContext()->setContextProperty("tinted", tinted);
 
   // ***** IMPORTANT *****
   // Load the compiled QML MODULE (KeyDash_NX1000), not a qrc file:
@@ -366,6 +460,22 @@ int main(int argc, char *argv[]) {
   if (engine.rootObjects().isEmpty())
       return -1;
 
+  // ==========================================================
+  //        Frame-coalesced DashModel updates
+  // ==========================================================
+  // Telemetry NOTIFYs are flushed once per rendered frame (afterAnimating
+  // runs on the GUI thread right before scene-graph sync). The first dirty
+  // value asks the window for a frame so a static scene still updates.
+  if (auto *win = qobject_cast<QQuickWindow *>(engine.rootObjects().first())) {
+      QObject::connect(win, &QQuickWindow::afterAnimating,
+                       &dash, &DashModel::flushPending);
+      QObject::connect(&dash, &DashModel::flushRequested,
+                       win, &QQuickWindow::update);
+      dash.setCoalesceUpdates(
+          settings.value("KeyDash/coalesceUpdates", true).toBool());
+      conn.latency()->attachWindow(win);
+  }
+
   return app.exec();
 
 }
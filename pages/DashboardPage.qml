@@ -2,6 +2,7 @@ import QtQuick
 import QtQuick.Controls
 import Qt.labs.settings 1.1
 import QtMultimedia
+import KeyDash.Render
 //import KeyDash_NX1000 1.0
 
 Page {
@@ -183,7 +184,6 @@ Page {
             visible: opacity > 0
         }
 
-        Loader { active: true; sourceComponent: Component { Image { source: "qrc:/KeyDash_Assets/assets/Tachometer_Full.png"; cache: true; visible: false } } }
         FontLoader { id: neu;        source: "qrc:/KeyDash_Assets/fonts/NeuropolX_Lite.ttf" }
         FontLoader { id: neu_italic; source: "qrc:/KeyDash_Assets/fonts/NeuropolX_Italic.ttf" }
         FontLoader { id: brandFont; source: "qrc:/KeyDash_Assets/fonts/NissanOpti.otf" }
@@ -306,45 +306,15 @@ Page {
             }
         }
 
+        // 3) Frame (lines, tach scale, etc.) — tinted with secondaryColor, PNG alpha kept
         Image {
-            id: frameImg
-            source: "qrc:/KeyDash_Assets/assets/DashFrame.png"
-            visible: false   // preload only
-        }
-
-        // 3) Frame (lines, tach scale, etc.) — tint with secondaryColor, keep PNG alpha
-        Canvas {
             id: frameTint
             anchors.fill: parent
             anchors.topMargin: -32
             anchors.bottomMargin: 32
             z: 3
-
-            property color tint: theme.secondaryColor
-            renderTarget: Canvas.FramebufferObject
-
-            onPaint: {
-                const ctx = getContext("2d")
-                ctx.clearRect(0, 0, width, height)
-
-                if (!frameImg.status === Image.Ready) {
-                    requestPaint()
-                    return
-                }
-
-                // draw the preloaded image
-                ctx.drawImage(frameImg, 0, 0, width, height)
-
-                // apply tint
-                ctx.globalCompositeOperation = "source-in"
-                ctx.fillStyle = tint
-                ctx.fillRect(0, 0, width, height)
-                ctx.globalCompositeOperation = "source-over"
-            }
-
-            onTintChanged: requestPaint()
-            onWidthChanged: requestPaint()
-            onHeightChanged: requestPaint()
+            source: tinted.url("qrc:/KeyDash_Assets/assets/DashFrame.png", theme.secondaryColor)
+            sourceSize: Qt.size(width, height)
         }
 
         // --- remove the baked-in "NISSAN" with a transparent patch ---
@@ -578,45 +548,12 @@ Page {
             }
 
             // --- tiny helper: PNG tint that preserves alpha ---
-            component TintedIcon: Canvas {
-                id: tint
+            component TintedIcon: Image {
                 property string src: ""
                 property color  tintColor: theme.secondaryColor
 
-                renderTarget: Canvas.FramebufferObject
-
-                Component.onCompleted: if (src) loadImage(src)
-                onSrcChanged: { if (src) loadImage(src); requestPaint() }
-                onTintColorChanged: requestPaint()
-                onWidthChanged:  requestPaint()
-                onHeightChanged: requestPaint()
-
-                onPaint: {
-                    const ctx = getContext("2d")
-                    const w = width, h = height
-                    ctx.clearRect(0, 0, w, h)
-
-                    if (!src || !isImageLoaded(src)) {
-                        requestPaint() // try again next frame once loaded
-                        return
-                    }
-
-                    // 1) draw the original (with its alpha)
-                    ctx.drawImage(src, 0, 0, w, h)
-
-                    // 2) fill only where the icon is opaque
-                    ctx.globalCompositeOperation = "source-in"
-                    ctx.fillStyle = tintColor
-                    ctx.fillRect(0, 0, w, h)
-
-                    ctx.globalCompositeOperation = "source-over"
-                }
-
-                // repaint live when theme changes
-                Connections {
-                    target: theme
-                    function onSecondaryColorChanged() { tint.requestPaint() }
-                }
+                source: tinted.url(src, tintColor)
+                sourceSize: Qt.size(width, height)
             }
 
             component MetricRow: Item {
@@ -1027,63 +964,20 @@ Page {
                 ScriptAction { script: rpmBar.sweeping = false }   // Binding reattaches
             }
 
-            // Clipping window that reveals the tach image based on displayFrac
-            Item {
-                anchors.left: parent.left
-                anchors.top: parent.top
-                anchors.bottom: parent.bottom
-                width: Math.round(rpmBar.width * rpmBar.displayFrac)  // clip width only
-                clip: true
-
-                // Draw at full size, let the parent clip reveal it
-                Item {
-                    x: 16                    // keep your original x offset
-                    y: 0
-                    width: rpmBar.width
-                    height: rpmBar.height
-
-                    Canvas {
-                        id: tachTint
-                        anchors.fill: parent
-                        renderTarget: Canvas.FramebufferObject
-
-                        property string src: "qrc:/KeyDash_Assets/assets/Tachometer_Full.png"
-                        property color  startColor: theme.secondaryColor
-                        property color  endColor:   "#ff0000"
-
-                        Component.onCompleted: loadImage(src)
-                        onSrcChanged: { loadImage(src); requestPaint() }
-                        onWidthChanged:  requestPaint()
-                        onHeightChanged: requestPaint()
-                        onStartColorChanged: requestPaint()
-                        onEndColorChanged:   requestPaint()
-
-                        Connections {
-                            target: theme
-                            function onSecondaryColorChanged() { tachTint.requestPaint() }
-                        }
-
-                        onPaint: {
-                            const ctx = getContext("2d")
-                            const w = width, h = height
-                            ctx.clearRect(0, 0, w, h)
-
-                            if (!isImageLoaded(src)) { requestPaint(); return }
-
-                            // Draw full-size image (no stretch with the clip)
-                            ctx.drawImage(src, 0, 0, w, h)
-
-                            // Gradient tint while preserving alpha
-                            ctx.globalCompositeOperation = "source-in"
-                            const g = ctx.createLinearGradient(0, 0, w, 0)
-                            g.addColorStop(0.0, startColor)
-                            g.addColorStop(1.0, endColor)
-                            ctx.fillStyle = g
-                            ctx.fillRect(0, 0, w, h)
-                            ctx.globalCompositeOperation = "source-over"
-                        }
-                    }
-                }
+            // Tach scale revealed up to displayFrac; the item only moves one
+            // textured quad's edge, so no clipping/re-layout per RPM change
+            TachSweep {
+                id: tachTint
+                x: 16                    // keep your original x offset
+                y: 0
+                width: rpmBar.width
+                height: rpmBar.height
+                // reveal edge stays at displayFrac of rpmBar, as the old clip did
+                fraction: width > 0 ? (rpmBar.width * rpmBar.displayFrac - x) / width : 0
+
+                source: "qrc:/KeyDash_Assets/assets/Tachometer_Full.png"
+                startColor: theme.secondaryColor
+                endColor:   "#ff0000"
             }
         }
 
@@ -3,8 +3,7 @@ import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
 import "qrc:/KeyDash_NX1000/style"
-import "../components"
-import "../scripts/LogParser.js" as LP
+import KeyDash.Replay
 import "qrc:/KeyDash_NX1000/pages" as Pages   // <-- your DashboardPage import
 
 Page {
@@ -43,9 +42,6 @@ Page {
         Qt.callLater(() => { if (autoPlay) replay.play(); });
     }
 
-    // Local state
-    property var lastFrame: ({ t:0, rpm:0, map:0, tps:0, clt:0, iat:0, afr:0, batt:0 })
-
     // 1) Local container so overlay can anchor to sibling components
     Item {
         id: stage
@@ -156,7 +152,7 @@ Page {
                                     id: timeCol
                                     anchors.centerIn: parent; spacing: 0
                                     Text {
-                                        text: (replay.position.toFixed(1) + " / " + Math.max(0, replay.duration).toFixed(1) + " s")
+                                        text: ((replay.position / 1000).toFixed(1) + " / " + (Math.max(0, replay.duration) / 1000).toFixed(1) + " s")
                                         color: "white"; font.pixelSize: 22
                                     }
                                     Text {
@@ -181,6 +177,119 @@ Page {
                     }
                 }
 
+                // Load progress (playback can already run on the loaded part)
+                RowLayout {
+                    Layout.fillWidth: true
+                    visible: replay.loading
+                    spacing: 10
+
+                    ProgressBar {
+                        Layout.fillWidth: true
+                        from: 0; to: 1
+                        value: replay.loadProgress
+                    }
+                    Text {
+                        text: "Loading " + Math.round(replay.loadProgress * 100) + " %"
+                        color: "#9fb0bd"; font.pixelSize: 16
+                    }
+                    ThemedButton {
+                        palette: page.reTheme
+                        text: "Cancel"
+                        implicitWidth: 120; implicitHeight: 48
+                        font.pixelSize: 18
+                        onClicked: replay.cancelLoad()
+                    }
+                }
+
+                // Overview: RPM / boost / AFR min-max traces over the whole log,
+                // one bucket per pixel from the engine's decimation pyramid
+                RowLayout {
+                    Layout.fillWidth: true
+                    visible: replay.duration > 0
+
+                    Item { Layout.fillWidth: true }
+
+                    Item {
+                        id: overview
+                        width: scrub.width
+                        height: 72
+                        implicitWidth: width
+                        implicitHeight: height
+
+                        readonly property var traces: [
+                            { column: "rpm",   color: "#4fc3f7" },
+                            { column: replay.hasColumn("boost") ? "boost" : "map", color: "#ffb74d" },
+                            { column: "afr",   color: "#81c784" }
+                        ]
+
+                        Rectangle {
+                            anchors.fill: parent
+                            radius: 8
+                            color: "#10212a"; border.color: "#28424d"
+                        }
+
+                        Canvas {
+                            id: overviewCanvas
+                            anchors.fill: parent
+                            anchors.margins: 4
+                            onWidthChanged: requestPaint()
+                            onPaint: {
+                                const ctx = getContext("2d")
+                                ctx.reset()
+                                const w = Math.floor(width), h = height
+                                if (w <= 0 || replay.duration <= 0)
+                                    return
+                                for (const tr of overview.traces) {
+                                    const s = replay.series(tr.column, 0, replay.duration, w)
+                                    if (!s.min)
+                                        continue
+                                    let lo = Infinity, hi = -Infinity
+                                    for (let i = 0; i < w; ++i) {
+                                        if (!isNaN(s.min[i])) lo = Math.min(lo, s.min[i])
+                                        if (!isNaN(s.max[i])) hi = Math.max(hi, s.max[i])
+                                    }
+                                    if (!(hi > lo))
+                                        continue
+                                    const k = (h - 2) / (hi - lo)
+                                    ctx.strokeStyle = tr.color
+                                    ctx.lineWidth = 1
+                                    ctx.beginPath()
+                                    for (let x = 0; x < w; ++x) {
+                                        if (isNaN(s.min[x]))
+                                            continue
+                                        ctx.moveTo(x + 0.5, h - 1 - (s.min[x] - lo) * k)
+                                        ctx.lineTo(x + 0.5, h - 1 - (s.max[x] - lo) * k - 1)
+                                    }
+                                    ctx.stroke()
+                                }
+                            }
+                            Connections {
+                                target: replay
+                                function onSeriesChanged() { overviewCanvas.requestPaint() }
+                            }
+                        }
+
+                        // Playhead
+                        Rectangle {
+                            width: 2; height: parent.height
+                            color: "white"
+                            x: overviewCanvas.x + overviewCanvas.width * (replay.duration > 0 ? replay.position / replay.duration : 0) - 1
+                        }
+
+                        MouseArea {
+                            anchors.fill: parent
+                            function seekFromX(xLocal) {
+                                const v = Math.max(0, Math.min(1, (xLocal - overviewCanvas.x) / overviewCanvas.width))
+                                replay.seek(v * Math.max(0, replay.duration))
+                            }
+                            onClicked: (mouse) => seekFromX(mouse.x)
+                            onPositionChanged: (mouse) => { if (pressed) seekFromX(mouse.x) }
+                        }
+                    }
+
+                    Item { Layout.fillWidth: true }
+                }
+
                 // Scrub bar: scaled to duration, centered, touch-friendly
                 RowLayout {
                     Layout.fillWidth: true
@@ -197,7 +306,7 @@ Page {
                         property real minBar: 320
                         property real maxBar: Math.min(overlay.width - 48, 1200)
 
-                        readonly property real desired: Math.max(0, Number(replay.duration) || 0) * pxPerSecond
+                        readonly property real desired: Math.max(0, Number(replay.duration) || 0) / 1000 * pxPerSecond
                         width: Math.max(minBar, Math.min(maxBar, desired))
                         height: 56
 
@@ -260,60 +369,11 @@ Page {
         }
     }
 
-    // 3) Replayer engine (headless)
-    LogReplayController {
+    // 3) Replayer engine (headless, C++): parses the log off the GUI thread
+    //    and feeds DashModel directly on every tick
+    LogReplayEngine {
         id: replay
-
-    // 3A) Push parsed frames into DashModel (tolerant mapping)
-        onFrameAdvanced: (f) => {
-            lastFrame = f
-
-            if (!page.dashController)
-                return
-
-            // Tolerant column mapping (handles mph/kph/speed, map/boost, batt/vbat, etc.)
-            const rpm   = (f.rpm   !== undefined) ? Number(f.rpm)   : 0
-            const mph   = (function(){
-                if (f.mph  !== undefined) return Number(f.mph)
-                if (f.speed!== undefined) return Number(f.speed)            // already in mph in your fake log
-                if (f.kph  !== undefined) return Number(f.kph) / 1.60934    // convert
-                if (f.kmh  !== undefined) return Number(f.kmh) / 1.60934
-                return 0
-            })()
-            const boost = (function(){
-                if (f.boost !== undefined) return Number(f.boost)
-                if (f.map   !== undefined) return Number(f.map) - 14.7       // crude: MAP(psia) - 14.7 ≈ boost psi
-                return 0
-            })()
-            const clt   = (f.clt   !== undefined) ? Number(f.clt)
-                        : (f.coolant !== undefined) ? Number(f.coolant) : NaN
-            const iat   = (f.iat   !== undefined) ? Number(f.iat)
-                        : (f.mat    !== undefined) ? Number(f.mat)    : NaN
-            const vbat  = (f.vbat  !== undefined) ? Number(f.vbat)
-                        : (f.batt   !== undefined) ? Number(f.batt)   : NaN
-            const afr   = (function(){
-                if (f.afr     !== undefined) return Number(f.afr)
-                if (f.lambda  !== undefined) return Number(f.lambda) * 14.7
-                return NaN
-            })()
-            const gear  = (f.gear  !== undefined) ? parseInt(f.gear, 10) : -1
-
-            // 3B) Feed the DashModel
-            if (page.dashController.applySample) {
-                // Use the one-shot applySample helper if available
-                page.dashController.applySample(rpm, mph, boost, clt, iat, vbat, afr, gear)
-            } else {
-                // Fallback: call individual setters if applySample is not available
-                if (page.dashController.setRpm)     page.dashController.setRpm(rpm)
-                if (page.dashController.setSpeed)   page.dashController.setSpeed(mph)
-                if (page.dashController.setBoost && !Number.isNaN(boost)) page.dashController.setBoost(boost)
-                if (page.dashController.setClt   && !Number.isNaN(clt))   page.dashController.setClt(clt)
-                if (page.dashController.setIat   && !Number.isNaN(iat))   page.dashController.setIat(iat)
-                if (page.dashController.setVbat  && !Number.isNaN(vbat))  page.dashController.setVbat(vbat)
-                if (page.dashController.setAfr   && !Number.isNaN(afr))   page.dashController.setAfr(afr)
-                if (page.dashController.setGear)  page.dashController.setGear(gear)
-            }
-        }
+        target: page.dashController
 
         // 3C) Manage replay mode and UI synchronization on load/end
         onLoaded: {
@@ -335,13 +395,16 @@ Page {
     Connections {
         target: replay
         function onLoaded() {
-            console.log("Replay loaded. duration =", replay.duration, "s, url =", replay.sourceUrl);
+            console.log("Replay loaded. duration =", replay.duration, "ms, url =", replay.sourceUrl);
         }
         function onEnded() {
             console.log("Replay ended.");
             overlay.visible = true;
         }
-        // If your LogReplayController exposes an error signal or status, hook it here too.
+        function onErrorChanged() {
+            if (replay.errorString.length)
+                console.warn("Replay failed:", replay.errorString, "url =", replay.sourceUrl);
+        }
     }
 
 }
@@ -64,63 +64,17 @@ Page {
     }
 
     // 3) Frame (lines, tach scale, etc.) — tint with secondaryColor, keep PNG alpha
-    Canvas {
+    Image {
         id: frameTint
         anchors.fill: parent
         anchors.topMargin: -32
         anchors.bottomMargin: 32
         z: 3
 
-        // Use the real asset path you ship (DashFrame.png unless you truly have BlankFrame.png)
-        property url   src: "qrc:/KeyDash_Assets/assets/BlankFrame.png"
-        property color tint: theme.secondaryColor
-
-        // FBO content can be dropped when the item is hidden; we’ll requestPaint() when visible again.
-        renderTarget: Canvas.FramebufferObject
-        antialiasing: true
-
-        function repaintIfReady() {
-            if (!isImageLoaded(src)) {
-                loadImage(src)         // kick off (or re-kick) async load
-                return
-            }
-            requestPaint()
-        }
-
-        Component.onCompleted: repaintIfReady()
-        onSrcChanged:          repaintIfReady()
-        onTintChanged:         repaintIfReady()
-        onWidthChanged:        repaintIfReady()
-        onHeightChanged:       repaintIfReady()
-        onVisibleChanged:      if (visible) repaintIfReady()
-
-        // Called by Canvas when any image finishes loading
-        onImageLoaded: function(url) {
-            if (url === src) requestPaint()
-        }
-
-        onPaint: {
-            const ctx = getContext("2d")
-            const w = width, h = height
-            ctx.clearRect(0, 0, w, h)
-
-            if (!isImageLoaded(src))
-                return  // wait for onImageLoaded() to trigger a repaint
-
-            // 1) draw original (alpha preserved)
-            ctx.drawImage(src, 0, 0, w, h)
-
-            // 2) colorize only where the PNG is opaque
-            ctx.globalCompositeOperation = "source-in"
-            ctx.fillStyle = tint
-            ctx.fillRect(0, 0, w, h)
-
-            // back to normal for anything that may draw later
-            ctx.globalCompositeOperation = "source-over"
-        }
+        source: tinted.url("qrc:/KeyDash_Assets/assets/BlankFrame.png", theme.secondaryColor)
+        sourceSize: Qt.size(width, height)
     }
 
-
     // --- remove the baked-in "NISSAN" with a transparent patch ---
     Canvas {
         id: frameBadgePatch
@@ -1351,7 +1305,7 @@ Page {
                     FolderListModel {
                         id: logs
                         folder: asUrl(svc.prefs.logDir)
-                        nameFilters: ["*.csv", "*.json"]
+                        nameFilters: ["*.csv", "*.json", "*.kdlog"]
                         showDirs: false
                         showDotAndDotDot: false
                         sortField: FolderListModel.Time
@@ -1384,7 +1338,7 @@ Page {
                                 Text {
                                     anchors.centerIn: parent
                                     text: (svc.prefs.logDir
-                                           && svc.prefs.logDir.length) ? "No .csv or .json logs found in this folder." : "Choose a log folder in Settings → Performance."
+                                           && svc.prefs.logDir.length) ? "No .csv, .json or .kdlog logs found in this folder." : "Choose a log folder in Settings → Performance."
                                     color: "#9fb0bd"
                                     font.pixelSize: 18
                                 }
@@ -3156,6 +3110,169 @@ Page {
                                         }
                                     }
 
+                                    // Transport → screen latency (per pipeline stage)
+                                    Column {
+                                        id: latencyBox
+                                        spacing: 6
+                                        property var rows: []
+
+                                        function fmtUs(us) {
+                                            return us >= 1000 ? (us / 1000).toFixed(1) + " ms"
+                                                              : Math.round(us) + " µs"
+                                        }
+
+                                        Timer {
+                                            interval: 1000
+                                            repeat: true
+                                            running: latencyBox.visible && typeof latency !== "undefined"
+                                            triggeredOnStart: true
+                                            onTriggered: latencyBox.rows = latency.stats()
+                                        }
+
+                                        Row {
+                                            spacing: 16
+                                            Text {
+                                                text: "Latency"
+                                                color: "white"
+                                                font.pixelSize: 22
+                                                anchors.verticalCenter: parent.verticalCenter
+                                            }
+                                            ThemedButton {
+                                                palette: theme
+                                                text: "Dump"
+                                                width: 140
+                                                height: 56
+                                                font.pixelSize: 20
+                                                onClicked: latency.dump(latency.defaultDumpPath())
+                                            }
+                                            ThemedButton {
+                                                palette: theme
+                                                text: "Reset"
+                                                width: 140
+                                                height: 56
+                                                font.pixelSize: 20
+                                                onClicked: { latency.reset(); latencyBox.rows = latency.stats() }
+                                            }
+                                        }
+
+                                        Repeater {
+                                            model: latencyBox.rows
+                                            delegate: Text {
+                                                color: "white"
+                                                font.pixelSize: 18
+                                                font.family: "monospace"
+                                                text: modelData.stage + "  p50 " + latencyBox.fmtUs(modelData.p50Us)
+                                                      + "  p95 " + latencyBox.fmtUs(modelData.p95Us)
+                                                      + "  p99 " + latencyBox.fmtUs(modelData.p99Us)
+                                                      + "  max " + latencyBox.fmtUs(modelData.maxUs)
+                                                      + "  (n=" + modelData.count + ")"
+                                            }
+                                        }
+                                    }
+
+                                    // Raw transport capture (replay with the "Replay capture" transport)
+                                    Column {
+                                        id: captureBox
+                                        spacing: 6
+                                        property string format: "kdcap"
+                                        property var st: ({})
+
+                                        Timer {
+                                            interval: 1000
+                                            repeat: true
+                                            running: captureBox.visible && typeof capture !== "undefined"
+                                            triggeredOnStart: true
+                                            onTriggered: captureBox.st = capture.stats()
+                                        }
+
+                                        Row {
+                                            spacing: 16
+                                            Text {
+                                                text: "Capture"
+                                                color: "white"
+                                                font.pixelSize: 22
+                                                anchors.verticalCenter: parent.verticalCenter
+                                            }
+                                            ThemedButton {
+                                                palette: theme
+                                                text: capture.running ? "Stop" : "Record"
+                                                width: 140
+                                                height: 56
+                                                font.pixelSize: 20
+                                                onClicked: {
+                                                    if (capture.running) capture.stop()
+                                                    else capture.startSession(captureBox.format)
+                                                    captureBox.st = capture.stats()
+                                                }
+                                            }
+                                            ThemedButton {
+                                                palette: theme
+                                                text: captureBox.format === "kdcap" ? ".kdcap" : "candump"
+                                                enabled: !capture.running
+                                                width: 160
+                                                height: 56
+                                                font.pixelSize: 20
+                                                onClicked: captureBox.format = captureBox.format === "kdcap" ? "candump" : "kdcap"
+                                            }
+                                        }
+
+                                        Text {
+                                            visible: captureBox.st.path !== undefined && captureBox.st.path !== ""
+                                            color: "white"
+                                            font.pixelSize: 18
+                                            font.family: "monospace"
+                                            text: captureBox.st.path + "\n"
+                                                  + captureBox.st.records + " records  "
+                                                  + Math.round(captureBox.st.bytesWritten / 1024) + " KiB  dropped "
+                                                  + captureBox.st.dropped + "  backlog peak "
+                                                  + Math.round(captureBox.st.maxBacklog / 1024) + " KiB"
+                                        }
+                                    }
+
+                                    // Pipeline health: bytes/frames in, checksum failures, resyncs, drops, RTT
+                                    Column {
+                                        id: pipelineBox
+                                        spacing: 4
+
+                                        Row {
+                                            spacing: 16
+                                            Text {
+                                                text: "Pipeline"
+                                                color: "white"
+                                                font.pixelSize: 22
+                                                anchors.verticalCenter: parent.verticalCenter
+                                            }
+                                            ThemedButton {
+                                                palette: theme
+                                                text: "Snapshot"
+                                                width: 160
+                                                height: 56
+                                                font.pixelSize: 20
+                                                onClicked: pipelineMetrics.writeSnapshot(pipelineMetrics.snapshotPath())
+                                            }
+                                        }
+
+                                        Repeater {
+                                            model: typeof pipelineMetrics !== "undefined" ? pipelineMetrics : null
+                                            delegate: Text {
+                                                color: "white"
+                                                font.pixelSize: 18
+                                                font.family: "monospace"
+                                                text: {
+                                                    switch (model.kind) {
+                                                    case "counter":
+                                                        return model.name + "  " + model.value + "  (" + model.rate.toFixed(1) + "/s)"
+                                                    case "gauge":
+                                                        return model.name + "  " + model.value + "  peak " + model.peak
+                                                    default:
+                                                        return model.name + "  n=" + model.value + "  p50 " + model.p50
+                                                               + "  p99 " + model.p99 + "  max " + model.peak
+                                                    }
+                                                }
+                                            }
+                                        }
+                                    }
+
                                     HoldButton {
                                         label: "Hold to Reset Trip"
                                         holdMs: 1200
@@ -39,6 +39,8 @@ Page {
                 ButtonGroup { id: transportGroup }
                 RadioButton { text: "Serial"; checked: true; ButtonGroup.group: transportGroup; property string key: "serial" }
                 RadioButton { text: "CAN (socketcan)"; ButtonGroup.group: transportGroup; property string key: "can" }
+                RadioButton { text: "SocketCAN (native)"; ButtonGroup.group: transportGroup; property string key: "socketcan" }
+                RadioButton { text: "Replay capture"; ButtonGroup.group: transportGroup; property string key: "replay" }
             }
         }
 
@@ -51,9 +53,23 @@ Page {
         }
 
         RowLayout {
-            visible: transportGroup.checkedButton && transportGroup.checkedButton.key === "can"
+            visible: transportGroup.checkedButton && (transportGroup.checkedButton.key === "can"
+                                                      || transportGroup.checkedButton.key === "socketcan")
             spacing: 12; Layout.fillWidth: true
-            TextField { id: canIf; placeholderText: "can0"; Layout.fillWidth: true; text: "can0" }
+            TextField { id: canIf; placeholderText: "can0 (native: can0,can1)"; Layout.fillWidth: true; text: "can0" }
+        }
+
+        RowLayout {
+            visible: transportGroup.checkedButton && transportGroup.checkedButton.key === "replay"
+            spacing: 12; Layout.fillWidth: true
+            TextField { id: capturePath; placeholderText: "Capture file (.kdcap or candump .log)"; Layout.fillWidth: true }
+            ComboBox {
+                id: replaySpeed
+                model: [ { text: "1×", speed: 1 }, { text: "2×", speed: 2 }, { text: "10×", speed: 10 }, { text: "Max", speed: 0 } ]
+                textRole: "text"
+                onActivated: connCtrl.replaySpeed = model[currentIndex].speed
+            }
+            CheckBox { text: "Loop"; checked: connCtrl.replayLoop; onToggled: connCtrl.replayLoop = checked }
         }
 
         GroupBox {
@@ -65,10 +81,22 @@ Page {
                 RadioButton { text: "Demo (no hardware)"; ButtonGroup.group: protoGroup; property string key: "Demo" }
                 RadioButton { text: "OBD2/ELM327"; checked: true; ButtonGroup.group: protoGroup; property string key: "OBD2" }
                 RadioButton { text: "ECUMaster Classic"; ButtonGroup.group: protoGroup; property string key: "ECUMasterClassic" }
+                RadioButton { text: "CAN (DBC)"; ButtonGroup.group: protoGroup; property string key: "DBC" }
                 // Later: RadioButton { text: "ECUMaster Black (CAN)"; ButtonGroup.group: protoGroup; property string key: "ECUMasterBlack" }
             }
         }
 
+        RowLayout {
+            visible: protoGroup.checkedButton && protoGroup.checkedButton.key === "DBC"
+            spacing: 12; Layout.fillWidth: true
+            TextField {
+                placeholderText: "DBC file (e.g. /home/pi/haltech.dbc)"
+                Layout.fillWidth: true
+                text: connCtrl.dbcPath
+                onTextEdited: connCtrl.dbcPath = text
+            }
+        }
+
         Label { text: statusText; color: statusText.indexOf("Failed")>=0 ? "tomato" : "lightgreen" }
 
         Button {
@@ -76,11 +104,12 @@ Page {
           onClicked: {
             const tKey = transportGroup.checkedButton ? transportGroup.checkedButton.key : "serial"
             const pKey = protoGroup.checkedButton ? protoGroup.checkedButton.key : "Demo"
-            const ok = connCtrl.apply(tKey, port.text, baud.value, canIf.text, pKey)
+            const src = (tKey === "replay") ? capturePath.text : port.text
+            const ok = connCtrl.apply(tKey, src, baud.value, canIf.text, pKey)
             root.statusText = ok ? "Connecting..." : "Failed to start — see status line"
             console.debug("Transport:", tKey, "Port:", port.text || "<empty>", "Baud:", baud.value, "Proto:", pKey, "=>", ok)
           }
         }
-        Label { text: "Tip: OBD2 uses an ELM327 adapter on a serial COM/tty port. CAN uses socketcan (can0)." }
+        Label { text: "Tip: OBD2 uses an ELM327 adapter on a serial COM/tty port. CAN uses socketcan (can0) with a DBC file." }
     }
 }
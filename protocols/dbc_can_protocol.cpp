@@ -0,0 +1,131 @@
+#include "dbc_can_protocol.h"
+#include "core/itransport.h"
+#include "core/signal_registry.h"
+#include <QDateTime>
+#include <QFile>
+
+DbcCanProtocol::DbcCanProtocol(const QString &dbcPath, QObject *parent)
+    : IECUProtocol(parent), m_path(dbcPath), m_flush(this) {
+    m_flush.setSingleShot(true);
+    m_flush.setInterval(0); // after the transport's read loop returns
+    connect(&m_flush, &QTimer::timeout, this, [this] { flush(); });
+}
+
+SignalId DbcCanProtocol::wellKnownFor(const QString &signalName) {
+    QString n;
+    for (QChar c : signalName)
+        if (c.isLetterOrNumber()) n.append(c.toLower());
+
+    if (n == "rpm" || n == "enginerpm" || n == "enginespeed" || n == "engspeed")
+        return Sig::EngineRpm;
+    if (n == "map" || n == "mapkpa" || n == "manifoldpressure")
+        return Sig::EngineMapKpa;
+    if (n == "tps" || n == "throttle" || n == "throttleposition")
+        return Sig::EngineTpsPercent;
+    if (n == "clt" || n == "ect" || n == "coolanttemp" || n == "coolanttemperature")
+        return Sig::TempsCltC;
+    if (n == "iat" || n == "mat" || n == "airtemp" || n == "intakeairtemp" || n == "intakeairtemperature")
+        return Sig::TempsIatC;
+    if (n == "vbat" || n == "batteryvoltage" || n == "batteryvolts" || n == "battvolts")
+        return Sig::ElectricalVbat;
+    if (n == "afr" || n == "airfuelratio")
+        return Sig::LambdaAfr;
+    if (n == "lambda" || n == "lambda1")
+        return Sig::LambdaLambda;
+    if (n == "baro" || n == "barometricpressure")
+        return Sig::EngineBaroKpa;
+    if (n == "vss" || n == "speed" || n == "vehiclespeed")
+        return Sig::VehicleSpeedKph;
+    if (n == "gear" || n == "currentgear")
+        return Sig::DrivetrainGear;
+    return Sig::Invalid;
+}
+
+bool DbcCanProtocol::probe(ITransport *t) {
+    m_ct = (t && t->kind() == ITransport::Kind::Can) ? t : nullptr;
+    if (!m_ct) return false;
+    connect(m_ct, &ITransport::canIn, this, &DbcCanProtocol::onFrame, Qt::UniqueConnection);
+    connect(m_ct, &ITransport::canFrames, this, &DbcCanProtocol::onFrames, Qt::UniqueConnection);
+    return true;
+}
+
+bool DbcCanProtocol::start(ITransport *t) {
+    Q_UNUSED(t);
+    if (!m_ct) return false;
+
+    QFile f(m_path);
+    QString err;
+    if (!f.open(QIODevice::ReadOnly) || !m_db.load(&f, &err)) {
+        emit statusChanged(QString("DBC load failed: %1").arg(err.isEmpty() ? m_path : err));
+        return false;
+    }
+
+    // Intern every signal once; the frame path only indexes m_ids.
+    auto &reg = SignalRegistry::instance();
+    m_ids.resize(m_db.signalCount());
+    for (int i = 0; i < m_db.signalCount(); ++i) {
+        const DbcDatabase::SignalInfo &s = m_db.signalInfo(i);
+        SignalId id = wellKnownFor(s.name);
+        if (id == Sig::Invalid)
+            id = reg.intern(QStringLiteral("CAN.") + s.message + QLatin1Char('.') + s.name);
+        m_ids[i] = id;
+    }
+
+    m_running = true;
+    emit statusChanged(QString("CAN (DBC) started, %1 messages / %2 signals")
+                           .arg(m_db.messageCount()).arg(m_db.signalCount()));
+    return true;
+}
+
+QVector<CanId> DbcCanProtocol::canIds() const {
+    QVector<CanId> ids;
+    ids.reserve(m_db.messageCount());
+    for (const DbcDatabase::Message &m : m_db.messages())
+        if (m.opCount > 0 && m.id <= 0x1FFFFFFF) // skips VECTOR__INDEPENDENT_SIG_MSG
+            ids.append({m.id, m.extended});
+    return ids;
+}
+
+void DbcCanProtocol::stop() {
+    m_running = false;
+    m_flush.stop();
+    flush();
+}
+
+int DbcCanProtocol::decodeOne(quint32 id, bool extended, const char *data, int len, qint64 now) {
+    int n = 0;
+    const bool known = m_db.decode(id, extended, data, len, [&](int sig, double v) {
+        push(m_ids[sig], v, now);
+        ++n;
+    });
+    return known ? n : -1;
+}
+
+void DbcCanProtocol::onFrame(quint32 id, const QByteArray &payload, bool extended) {
+    if (!m_running) return;
+    m_mFrames->add();
+    const int n = decodeOne(id, extended, payload.constData(), int(payload.size()), QDateTime::currentMSecsSinceEpoch());
+    if (n < 0) {
+        m_mUnknown->add();
+        return;
+    }
+    m_mSignals->add(quint64(n));
+    if (n && !m_flush.isActive())
+        m_flush.start();
+}
+
+void DbcCanProtocol::onFrames(const RawCanFrame *frames, int count) {
+    if (!m_running) return;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    quint64 samples = 0, unknown = 0;
+    for (int i = 0; i < count; ++i) {
+        const RawCanFrame &f = frames[i];
+        const int n = decodeOne(f.id, f.flags & RawCanFrame::Extended, reinterpret_cast<const char *>(f.data), f.len, now);
+        if (n < 0) ++unknown;
+        else samples += quint64(n);
+    }
+    m_mFrames->add(quint64(count));
+    m_mUnknown->add(unknown);
+    m_mSignals->add(samples);
+    flush();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "core/iecuprotocol.h"
+#include "core/pipeline_metrics.h"
+#include "protocols/dbc_database.h"
+#include <QTimer>
+#include <QVector>
+
+class ITransport;
+
+// Generic CAN broadcast decoder driven by a DBC file (Haltech, Link, MoTeC,
+// OEM buses, ...). Frames from ITransport::canIn go through the compiled
+// DbcDatabase; each signal is published as "CAN.<Message>.<Signal>", or as
+// the matching well-known id when its name is an obvious one (RPM, CLT,
+// MAP, ...; values are taken in the DBC's units).
+//
+// canFrames() batches are decoded and flushed as one sample batch each;
+// canIn arrives one frame per emission, so those samples are queued and
+// flushed once the current transport read has been handled.
+class DbcCanProtocol : public IECUProtocol {
+    Q_OBJECT
+  public:
+    explicit DbcCanProtocol(const QString &dbcPath, QObject *parent=nullptr);
+    QString name() const override { return "CAN (DBC)"; }
+
+    bool probe(ITransport *t) override;  // any CAN transport
+    bool start(ITransport *t) override;  // load and compile the DBC
+    void stop() override;
+    QVector<CanId> canIds() const override; // every message in the DBC
+
+    const DbcDatabase &database() const { return m_db; }
+
+           // Well-known id for a DBC signal name, Sig::Invalid if none
+    static SignalId wellKnownFor(const QString &signalName);
+
+  public slots:
+    void onFrame(quint32 id, const QByteArray &payload, bool extended);
+    void onFrames(const RawCanFrame *frames, int count);
+
+  private:
+    int decodeOne(quint32 id, bool extended, const char *data, int len, qint64 now); // samples, -1 unknown id
+
+    QString m_path;
+    ITransport *m_ct{nullptr};
+    DbcDatabase m_db;
+    QVector<SignalId> m_ids; // DBC signal index -> SignalId
+    QTimer m_flush;
+    bool m_running{false};
+
+    PipelineMetrics::Counter *m_mFrames  = PipelineMetrics::instance().counter("dbc.frames");
+    PipelineMetrics::Counter *m_mUnknown = PipelineMetrics::instance().counter("dbc.unknownIds");
+    PipelineMetrics::Counter *m_mSignals = PipelineMetrics::instance().counter("dbc.signals");
+};
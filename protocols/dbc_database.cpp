@@ -0,0 +1,153 @@
+#include "dbc_database.h"
+#include <QIODevice>
+#include <QRegularExpression>
+
+namespace {
+
+// BO_ 2147484672 EngineData: 8 Vector__XXX
+const QRegularExpression &messageRe() {
+    static const QRegularExpression re(QStringLiteral(R"(^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+))"));
+    return re;
+}
+
+// SG_ RPM M : 7|16@0+ (0.25,0) [0|16383.75] "rpm" Vector__XXX
+const QRegularExpression &signalRe() {
+    static const QRegularExpression re(QStringLiteral(
+        R"(^SG_\s+(\w+)\s*(M|m(\d+)M?)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*)"
+        R"(\(\s*([^,\s]+)\s*,\s*([^)\s]+)\s*\)\s*\[[^\]]*\]\s*"([^"]*)")"));
+    return re;
+}
+
+constexpr quint32 kDbcExtendedFlag = 0x80000000u;
+
+} // namespace
+
+bool DbcDatabase::load(QIODevice *dev, QString *error) {
+    DbcDatabase next;
+    auto fail = [&](int line, const QString &what) {
+        if (error) *error = QStringLiteral("line %1: %2").arg(line).arg(what);
+        return false;
+    };
+
+    // Signals are grouped under the BO_ that precedes them, so each
+    // message's ops end up contiguous.
+    QString msgName;
+    int lineNo = 0;
+    while (!dev->atEnd()) {
+        const QString line = QString::fromUtf8(dev->readLine()).trimmed();
+        ++lineNo;
+        if (line.startsWith(QLatin1String("BO_ "))) {
+            const auto m = messageRe().match(line);
+            if (!m.hasMatch()) return fail(lineNo, QStringLiteral("malformed BO_"));
+            const quint32 raw = m.captured(1).toUInt();
+            Message msg;
+            msg.id       = raw & ~kDbcExtendedFlag;
+            msg.extended = (raw & kDbcExtendedFlag) || msg.id >= quint32(kStdIds);
+            msg.firstOp  = next.m_ops.size();
+            msgName      = m.captured(2);
+            next.m_messages.append(msg);
+            continue;
+        }
+        if (!line.startsWith(QLatin1String("SG_ ")))
+            continue; // CM_, VAL_, BA_ ... carry nothing the decoder needs
+        if (next.m_messages.isEmpty()) return fail(lineNo, QStringLiteral("SG_ outside a message"));
+
+        const auto m = signalRe().match(line);
+        if (!m.hasMatch()) return fail(lineNo, QStringLiteral("malformed SG_"));
+        const int start  = m.captured(4).toInt();
+        const int length = m.captured(5).toInt();
+        if (length < 1 || length > 64 || start > 63)
+            return fail(lineNo, QStringLiteral("signal %1 out of range").arg(m.captured(1)));
+
+        Op op;
+        op.length   = quint8(length);
+        op.mask     = length == 64 ? ~quint64(0) : (quint64(1) << length) - 1;
+        op.motorola = m.captured(6) == QLatin1String("0");
+        op.isSigned = m.captured(7) == QLatin1String("-");
+        op.factor   = m.captured(8).toDouble();
+        op.offset   = m.captured(9).toDouble();
+        if (op.motorola) {
+            // Start bit is the MSB in DBC "sawtooth" numbering; locate it in
+            // the big-endian frame word and shift down to its LSB.
+            const int msb = 56 - 8 * (start / 8) + start % 8;
+            const int lsb = msb - length + 1;
+            if (lsb < 0) return fail(lineNo, QStringLiteral("signal %1 runs past the frame").arg(m.captured(1)));
+            op.shift = quint8(lsb);
+            op.bytes = quint8((63 - lsb) / 8 + 1);
+        } else {
+            if (start + length > 64) return fail(lineNo, QStringLiteral("signal %1 runs past the frame").arg(m.captured(1)));
+            op.shift = quint8(start);
+            op.bytes = quint8((start + length - 1) / 8 + 1);
+        }
+
+        Message &msg = next.m_messages.last();
+        const QString muxTag = m.captured(2);
+        if (muxTag == QLatin1String("M")) {
+            if (msg.muxOp >= 0) return fail(lineNo, QStringLiteral("second multiplexer in %1").arg(msgName));
+            msg.muxOp = next.m_ops.size();
+        } else if (!muxTag.isEmpty()) {
+            op.mux = m.captured(3).toInt(); // "m<n>M" (extended) decodes as plain m<n>
+        }
+
+        next.m_ops.append(op);
+        next.m_info.append({msgName, m.captured(1), m.captured(10)});
+        ++msg.opCount;
+    }
+    if (next.m_messages.size() > 32767) return fail(lineNo, QStringLiteral("too many messages"));
+
+    next.m_std.fill(-1, kStdIds);
+    for (int i = 0; i < next.m_messages.size(); ++i) {
+        const Message &msg = next.m_messages[i];
+        if (!msg.extended && next.m_std[int(msg.id)] < 0)
+            next.m_std[int(msg.id)] = qint16(i);
+    }
+    if (!next.buildExtHash()) return fail(lineNo, QStringLiteral("cannot index extended ids"));
+
+    *this = next;
+    return true;
+}
+
+bool DbcDatabase::buildExtHash() {
+    QVector<quint32> ids;
+    QVector<qint16> idx;
+    for (int i = 0; i < m_messages.size(); ++i) {
+        const quint32 id = m_messages[i].id;
+        if (m_messages[i].extended && !ids.contains(id)) {
+            ids.append(id);
+            idx.append(qint16(i));
+        }
+    }
+    m_extKeys.clear();
+    m_extIdx.clear();
+    if (ids.isEmpty()) return true;
+
+    // Search odd multipliers for one that maps every id to its own slot,
+    // doubling the table when a size runs out of candidates. A DBC has at
+    // most a few hundred ids, so this settles at 2-8x the id count.
+    int bits = 1;
+    while ((1 << bits) < 2 * ids.size()) ++bits;
+    quint32 seed = 0x9E3779B1u;
+    for (; bits <= 16; ++bits) {
+        const int size = 1 << bits;
+        for (int attempt = 0; attempt < 256; ++attempt) {
+            seed = seed * 1664525u + 1013904223u;
+            const quint32 mul = seed | 1u;
+            QVector<quint32> keys(size, 0);
+            QVector<qint16> slots(size, -1);
+            bool ok = true;
+            for (int k = 0; k < ids.size() && ok; ++k) {
+                const int s = int((ids[k] * mul) >> (32 - bits));
+                if (slots[s] >= 0) ok = false;
+                else { keys[s] = ids[k]; slots[s] = idx[k]; }
+            }
+            if (ok) {
+                m_extKeys  = keys;
+                m_extIdx   = slots;
+                m_extMul   = mul;
+                m_extShift = 32 - bits;
+                return true;
+            }
+        }
+    }
+    return false;
+}
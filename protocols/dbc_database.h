@@ -0,0 +1,119 @@
+#pragma once
+#include <QString>
+#include <QVector>
+#include <QtEndian>
+#include <QtGlobal>
+#include <cstring>
+
+class QIODevice;
+
+// CAN database compiled from a DBC file (BO_ / SG_ sections).
+//
+// Every signal is compiled at load time into one extraction op: the frame
+// is read once as a little-endian and a big-endian 64-bit word, and a signal
+// is a shift, a mask, an optional sign extension and one multiply-add.
+// Message lookup is a flat 2048-entry table for 11-bit (standard) ids and a
+// collision-free multiplicative hash for 29-bit (extended) ones, so decode()
+// does no hashing of strings, no allocation and at most one probe. The
+// frame format is part of the key: extended 0x100 is not standard 0x100.
+// Messages declared without the extended flag but with an id above 0x7FF
+// are taken as extended.
+//
+// Simple multiplexing is supported (one "M" switch per message, "m<n>"
+// signals); extended multiplexing (SG_MUL_VAL_) and CAN FD payloads beyond
+// 8 bytes are not.
+class DbcDatabase {
+  public:
+    struct Op {
+        quint64 mask     = 0;
+        double  factor   = 1.0;
+        double  offset   = 0.0;
+        quint8  shift    = 0;     // right shift of the frame word
+        quint8  length   = 0;     // bits
+        quint8  bytes    = 0;     // payload bytes the signal needs
+        bool    motorola = false; // big-endian (@0)
+        bool    isSigned = false;
+        qint32  mux      = -1;    // required switch value, -1 = always present
+    };
+
+    struct Message {
+        quint32 id       = 0;
+        bool    extended = false;
+        int     firstOp  = 0;  // ops [firstOp, firstOp + opCount)
+        int     opCount  = 0;
+        int     muxOp    = -1; // index of the switch signal, -1 = none
+    };
+
+           // Per-signal metadata for the UI / signal naming (not used to decode)
+    struct SignalInfo {
+        QString message;
+        QString name;
+        QString unit;
+    };
+
+    // Parse a DBC file. On failure the previous database is kept.
+    bool load(QIODevice *dev, QString *error = nullptr);
+
+    int messageCount() const { return m_messages.size(); }
+    const QVector<Message> &messages() const { return m_messages; }
+    int signalCount() const { return m_ops.size(); }
+    const SignalInfo &signalInfo(int i) const { return m_info[i]; }
+    const Message *message(quint32 id, bool extended) const {
+        const int m = messageIndex(id, extended);
+        return m < 0 ? nullptr : &m_messages[m];
+    }
+
+    // Decode one frame: onSignal(signalIndex, value) for each signal present
+    // in it. Returns false if the id is not in the database.
+    template <typename Fn>
+    bool decode(quint32 id, bool extended, const char *data, int len, Fn &&onSignal) const {
+        const int m = messageIndex(id, extended);
+        if (m < 0) return false;
+        const Message &msg = m_messages[m];
+
+        uchar b[8] = {};
+        std::memcpy(b, data, size_t(qBound(0, len, 8)));
+        const quint64 le = qFromLittleEndian<quint64>(b);
+        const quint64 be = qFromBigEndian<quint64>(b);
+
+        qint64 muxValue = -1;
+        if (msg.muxOp >= 0 && m_ops[msg.muxOp].bytes <= len)
+            muxValue = extract(m_ops[msg.muxOp], le, be);
+
+        const Op *op = m_ops.constData() + msg.firstOp;
+        for (int i = 0; i < msg.opCount; ++i, ++op) {
+            if (op->bytes > len) continue; // short frame
+            if (op->mux >= 0 && op->mux != muxValue) continue;
+            onSignal(msg.firstOp + i, double(extract(*op, le, be)) * op->factor + op->offset);
+        }
+        return true;
+    }
+
+    static qint64 extract(const Op &op, quint64 le, quint64 be) {
+        const quint64 raw = ((op.motorola ? be : le) >> op.shift) & op.mask;
+        if (op.isSigned && op.length < 64 && (raw >> (op.length - 1)) & 1)
+            return qint64(raw | ~op.mask);
+        return qint64(raw);
+    }
+
+  private:
+    static constexpr int kStdIds = 2048;
+
+    int messageIndex(quint32 id, bool extended) const {
+        if (!extended) return (id < quint32(kStdIds) && !m_std.isEmpty()) ? m_std[int(id)] : -1;
+        if (m_extKeys.isEmpty()) return -1;
+        const int slot = int((id * m_extMul) >> m_extShift);
+        return m_extKeys[slot] == id ? m_extIdx[slot] : -1;
+    }
+
+    bool buildExtHash();
+
+    QVector<Message>    m_messages;
+    QVector<Op>         m_ops;      // signal index == op index
+    QVector<SignalInfo> m_info;
+    QVector<qint16>     m_std;      // 11-bit id -> message, -1 unknown
+    QVector<quint32>    m_extKeys;  // perfect hash of the 29-bit ids
+    QVector<qint16>     m_extIdx;
+    quint32             m_extMul   = 0;
+    int                 m_extShift = 32;
+};
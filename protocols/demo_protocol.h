@@ -19,7 +19,7 @@ class DemoProtocol : public IECUProtocol {
     void stop() override { tick_.stop(); }
 
   private:
-    QTimer tick_;
+    QTimer tick_{this}; // child, so it follows moveToThread()
     double t_ = 0;
 
   private slots:
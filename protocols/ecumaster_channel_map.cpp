@@ -0,0 +1,82 @@
+#include "ecumaster_channel_map.h"
+#include <QIODevice>
+#include <QXmlStreamReader>
+
+namespace {
+
+EcuMasterChannelMap::Storage storageFromString(QStringView s) {
+    using S = EcuMasterChannelMap::Storage;
+    if (s.compare(u"sword", Qt::CaseInsensitive) == 0) return S::SWord;
+    if (s.compare(u"ubyte", Qt::CaseInsensitive) == 0) return S::UByte;
+    if (s.compare(u"sbyte", Qt::CaseInsensitive) == 0) return S::SByte;
+    if (s.compare(u"percent7", Qt::CaseInsensitive) == 0) return S::Percent7;
+    return S::Word;
+}
+
+} // namespace
+
+EcuMasterChannelMap::EcuMasterChannelMap() {
+    for (int ch = 0; ch < 256; ++ch) {
+        m_entries[ch].slot = slotFor(ch, QString());
+        m_names.append(QString());
+        m_units.append(QString());
+    }
+}
+
+EcuMasterChannelMap::Slot EcuMasterChannelMap::slotFor(int ch, const QString &name) {
+    // BARO / atmospheric kPa is matched by name; everything else by the
+    // v1.218 channel number.
+    if (name.contains(QLatin1String("baro"), Qt::CaseInsensitive) ||
+        name.contains(QLatin1String("atmo"), Qt::CaseInsensitive))
+        return Slot::Baro;
+    switch (ch) {
+    case 1:  return Slot::Rpm;    // RPM word/1
+    case 2:  return Slot::Map;    // MAP kPa word/1
+    case 3:  return Slot::Tps;    // TPS % ubyte/1
+    case 4:  return Slot::Iat;    // IAT C sbyte/1
+    case 5:  return Slot::Batt;   // Batt word/37 V
+    case 12: return Slot::Afr;    // AFR ubyte/10
+    case 13: return Slot::Gear;   // gear sbyte/1
+    case 24: return Slot::Clt;    // CLT sword/1 C
+    case 27: return Slot::Lambda; // λ ubyte/128
+    case 28: return Slot::Speed;  // VSS km/h word/4
+    default: return Slot::None;
+    }
+}
+
+bool EcuMasterChannelMap::load(QIODevice *dev, QString *error) {
+    EcuMasterChannelMap next;
+
+    QXmlStreamReader xr(dev);
+    while (!xr.atEnd()) {
+        xr.readNext();
+        if (!xr.isStartElement() || xr.name() != QLatin1String("symbol"))
+            continue;
+        const auto a = xr.attributes();
+        if (!a.hasAttribute("channel"))
+            continue;
+        const int ch = a.value("channel").toInt();
+        if (ch < 0 || ch > 255)
+            continue;
+
+        const QString name    = a.value("name").toString();
+        const double  divider = a.hasAttribute("divider") ? a.value("divider").toDouble() : 1.0;
+
+        Entry &e  = next.m_entries[ch];
+        e.storage = storageFromString(a.value("storage"));
+        e.slot    = slotFor(ch, name);
+        e.mapped  = true;
+        e.scale   = divider != 0.0 ? 1.0 / divider : 1.0;
+        e.offset  = a.hasAttribute("offset") ? a.value("offset").toDouble() : 0.0;
+        next.m_names[ch] = name;
+        next.m_units[ch] = a.value("unit").toString();
+        ++next.m_symbols;
+    }
+    if (xr.hasError()) {
+        if (error)
+            *error = xr.errorString();
+        return false;
+    }
+    *this = next;
+    return true;
+}
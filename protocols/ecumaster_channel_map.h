@@ -0,0 +1,84 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+#include <array>
+
+class QIODevice;
+
+// ECUMaster classic channel map compiled from the <symbol channel="..">
+// entries of the EMU XML (e.g. proto/version1_218.xml).
+//
+// The XML is parsed once into a 256-entry table indexed by the channel byte,
+// so the per-frame path is a table load, a storage switch and one multiply-add:
+// no QString copies, no toLower(), no hashing. Names/units are kept on the
+// side for UI and logging only.
+class EcuMasterChannelMap {
+  public:
+    enum class Storage : quint8 { Word, SWord, UByte, SByte, Percent7 };
+
+    // Destination of a channel, resolved at load time from the v1.218 channel
+    // numbers (and the symbol name for BARO).
+    enum class Slot : quint8 {
+        None, Rpm, Map, Tps, Iat, Batt, Afr, Clt, Lambda, Baro, Speed, Gear
+    };
+
+    struct Entry {
+        Storage storage = Storage::Word;
+        Slot    slot    = Slot::None;
+        bool    mapped  = false; // channel present in the XML
+        double  scale   = 1.0;   // 1 / divider (divider 0 treated as 1)
+        double  offset  = 0.0;
+    };
+
+    EcuMasterChannelMap();
+
+    // Parse an EMU XML map. On failure the previous table is kept.
+    bool load(QIODevice *dev, QString *error = nullptr);
+
+    int symbolCount() const { return m_symbols; }
+
+    const Entry &operator[](quint8 ch) const { return m_entries[ch]; }
+    QString      name(quint8 ch) const { return m_names.at(ch); }
+    QString      unit(quint8 ch) const { return m_units.at(ch); }
+
+    // Raw decoders, one specialization per storage type.
+    template <Storage S> static qint32 decodeRaw(quint8 vh, quint8 vl) {
+        if constexpr (S == Storage::Word) {
+            return qint32((quint16(vh) << 8) | vl);
+        } else if constexpr (S == Storage::SWord) {
+            return qint32(qint16((quint16(vh) << 8) | vl));
+        } else if constexpr (S == Storage::SByte) {
+            return qint32(qint8(vl)); // 8-bit signals live in the low byte
+        } else {
+            return qint32(vl); // ubyte / percent7
+        }
+    }
+
+    static qint32 decodeRaw(Storage s, quint8 vh, quint8 vl) {
+        switch (s) {
+        case Storage::Word:     return decodeRaw<Storage::Word>(vh, vl);
+        case Storage::SWord:    return decodeRaw<Storage::SWord>(vh, vl);
+        case Storage::UByte:    return decodeRaw<Storage::UByte>(vh, vl);
+        case Storage::SByte:    return decodeRaw<Storage::SByte>(vh, vl);
+        case Storage::Percent7: return decodeRaw<Storage::Percent7>(vh, vl);
+        }
+        return 0;
+    }
+
+    static double scaleValue(const Entry &e, qint32 raw) { return raw * e.scale + e.offset; }
+
+    // Decode one frame payload to engineering units.
+    double decode(quint8 ch, quint8 vh, quint8 vl) const {
+        const Entry &e = m_entries[ch];
+        return scaleValue(e, decodeRaw(e.storage, vh, vl));
+    }
+
+  private:
+    static Slot slotFor(int ch, const QString &name);
+
+    std::array<Entry, 256> m_entries;
+    QStringList            m_names;
+    QStringList            m_units;
+    int                    m_symbols = 0;
+};
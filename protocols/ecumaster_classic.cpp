@@ -1,9 +1,34 @@
 #include "ecumaster_classic.h"
-#include "transports/serial_transport.h"
+#include "core/signal_registry.h"
+#include "core/itransport.h"
 #include <QDateTime>
+#include <QFile>
+
+namespace {
+
+SignalId signalForSlot(EcuMasterChannelMap::Slot slot) {
+    using Slot = EcuMasterChannelMap::Slot;
+    switch (slot) {
+    case Slot::Rpm:    return Sig::EngineRpm;
+    case Slot::Map:    return Sig::EngineMapKpa;
+    case Slot::Tps:    return Sig::EngineTpsPercent;
+    case Slot::Iat:    return Sig::TempsIatC;
+    case Slot::Batt:   return Sig::ElectricalVbat;
+    case Slot::Afr:    return Sig::LambdaAfr;
+    case Slot::Clt:    return Sig::TempsCltC;
+    case Slot::Lambda: return Sig::LambdaLambda;
+    case Slot::Baro:   return Sig::EngineBaroKpa;
+    case Slot::Speed:  return Sig::VehicleSpeedKph;
+    case Slot::Gear:   return Sig::DrivetrainGear;
+    case Slot::None:   break;
+    }
+    return Sig::Invalid;
+}
+
+} // namespace
 
 bool EcuMasterClassicProtocol::probe(ITransport *t) {
-    m_st = qobject_cast<SerialTransport*>(t);
+    m_st = (t && t->kind() == ITransport::Kind::ByteStream) ? t : nullptr;
     if (!m_st) return false;
     connect(m_st, &ITransport::bytesIn, this, &EcuMasterClassicProtocol::onSerial, Qt::UniqueConnection);
     return true; // Later: sniff your classic header to be strict
@@ -12,19 +37,46 @@ bool EcuMasterClassicProtocol::probe(ITransport *t) {
 bool EcuMasterClassicProtocol::start(ITransport *t) {
     Q_UNUSED(t);
     if (!m_st) return false;
-    emit statusChanged("ECUMaster Classic (serial) started");
+    if (!loadMap(defaultMapPath())) return false;
+    m_decoder.reset();
+    m_running = true;
+    emit statusChanged(QString("ECUMaster Classic (serial) started, %1 channels").arg(m_map.symbolCount()));
     return true;
 }
 
 void EcuMasterClassicProtocol::stop() {
-    // nothing yet
+    m_running = false;
+}
+
+bool EcuMasterClassicProtocol::loadMap(const QString &path) {
+    QFile f(path);
+    QString err;
+    if (!f.open(QIODevice::ReadOnly) || !m_map.load(&f, &err)) {
+        emit statusChanged(QString("ECUMaster map load failed: %1").arg(err.isEmpty() ? path : err));
+        return false;
+    }
+
+    // Intern every mapped channel once; well-known quantities use their
+    // normalized ids, the rest are published as "ECUMaster.<symbol>".
+    auto &reg = SignalRegistry::instance();
+    for (int ch = 0; ch < 256; ++ch) {
+        const auto &e = m_map[quint8(ch)];
+        SignalId id = signalForSlot(e.slot);
+        if (id == Sig::Invalid && e.mapped)
+            id = reg.intern(QStringLiteral("ECUMaster.") + m_map.name(quint8(ch)));
+        m_ids[ch] = e.mapped ? id : SignalId(Sig::Invalid);
+    }
+    return true;
 }
 
 void EcuMasterClassicProtocol::onSerial(const QByteArray &buf) {
-    Q_UNUSED(buf);
-    // TODO: plug your existing ecu_reader decode here and emit normalized signals, e.g.:
-    // const qint64 now = QDateTime::currentMSecsSinceEpoch();
-    // emit sig({"Engine.RPM", rpm, now});
-    // emit sig({"Temps.CLT_C", clt, now});
-    // emit sig({"Lambda.AFR", afr, now});
+    if (!m_running) return;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    m_decoder.feed(buf.constData(), buf.size(), [&](const EcuMasterFrameDecoder::Frame &f) {
+        const SignalId id = m_ids[f.ch];
+        if (id != Sig::Invalid)
+            push(id, m_map.decode(f.ch, f.vh, f.vl), now);
+    });
+    m_metrics.publish(m_decoder.stats());
+    flush();
 }
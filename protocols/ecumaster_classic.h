@@ -1,21 +1,38 @@
 #pragma once
 #include "core/iecuprotocol.h"
+#include "protocols/ecumaster_channel_map.h"
+#include "protocols/ecumaster_decoder_metrics.h"
+#include "protocols/ecumaster_frame_decoder.h"
+#include <array>
 
-class SerialTransport;
+class ITransport;
 
+// ECUMaster EMU "classic" serial stream: 5-byte [ch][0xA3][hi][lo][cs]
+// frames, decoded through the channel map from proto/version1_218.xml and
+// emitted as normalized signals (one batch per serial read).
 class EcuMasterClassicProtocol : public IECUProtocol {
     Q_OBJECT
   public:
     using IECUProtocol::IECUProtocol;
     QString name() const override { return "ECUMaster Classic"; }
 
-    bool probe(ITransport *t) override;   // we'll accept serial for now
-    bool start(ITransport *t) override;   // connect to serial, ready to parse
+    bool probe(ITransport *t) override;   // any byte-stream transport for now
+    bool start(ITransport *t) override;   // load channel map, ready to parse
     void stop() override;
 
+    static QString defaultMapPath() { return QStringLiteral(":/KeyDash_Assets/proto/version1_218.xml"); }
+    const EcuMasterFrameDecoder::Stats &decoderStats() const { return m_decoder.stats(); }
+
   private:
-    SerialTransport *m_st { nullptr };
+    ITransport *m_st { nullptr }; // any byte-stream transport (serial, replay)
+    EcuMasterFrameDecoder m_decoder;
+    EcuMasterDecoderMetrics m_metrics{QStringLiteral("ecumaster")};
+    EcuMasterChannelMap m_map;
+    std::array<SignalId, 256> m_ids{}; // channel byte -> signal (Invalid = skip)
+    bool m_running { false };
+
+    bool loadMap(const QString &path);
 
   private slots:
-    void onSerial(const QByteArray &buf); // TODO: call your existing frame parser here
+    void onSerial(const QByteArray &buf);
 };
@@ -0,0 +1,37 @@
+#pragma once
+#include <QString>
+#include "core/pipeline_metrics.h"
+#include "protocols/ecumaster_frame_decoder.h"
+
+// Forwards EcuMasterFrameDecoder::Stats into PipelineMetrics counters
+// ("<prefix>.frames256", "<prefix>.checksumFailures", ...). The decoder's
+// own stats stay plain integers on its thread; publish() adds the deltas
+// since the previous call, once per feed.
+class EcuMasterDecoderMetrics {
+  public:
+    explicit EcuMasterDecoderMetrics(const QString &prefix) {
+        auto &pm = PipelineMetrics::instance();
+        m_bytesIn   = pm.counter(prefix + ".bytesIn");
+        m_frames256 = pm.counter(prefix + ".frames256");
+        m_frames255 = pm.counter(prefix + ".frames255");
+        m_csFail    = pm.counter(prefix + ".checksumFailures");
+        m_resyncs   = pm.counter(prefix + ".resyncs");
+        m_discarded = pm.counter(prefix + ".bytesDiscarded");
+    }
+
+    void publish(const EcuMasterFrameDecoder::Stats &s) {
+        if (s.bytesIn < m_last.bytesIn) m_last = {}; // decoder was reset
+        m_bytesIn->add(s.bytesIn - m_last.bytesIn);
+        m_frames256->add((s.frames - s.frames255) - (m_last.frames - m_last.frames255));
+        m_frames255->add(s.frames255 - m_last.frames255);
+        m_csFail->add(s.checksumFailures - m_last.checksumFailures);
+        m_resyncs->add(s.resyncs - m_last.resyncs);
+        m_discarded->add(s.bytesDiscarded - m_last.bytesDiscarded);
+        m_last = s;
+    }
+
+  private:
+    PipelineMetrics::Counter *m_bytesIn, *m_frames256, *m_frames255;
+    PipelineMetrics::Counter *m_csFail, *m_resyncs, *m_discarded;
+    EcuMasterFrameDecoder::Stats m_last;
+};
@@ -0,0 +1,150 @@
+#pragma once
+#include <QtGlobal>
+#include <cstring>
+
+// Streaming decoder for the ECUMaster "classic" 5-byte serial frame:
+//
+//   [channel] [0xA3] [value hi] [value lo] [checksum]
+//
+// checksum = (channel + 0xA3 + hi + lo) % 256 (older firmwares use % 255).
+//
+// Incoming bytes land in a fixed-capacity ring and every complete frame is
+// decoded in a single pass per feed(); nothing is shifted per frame and no
+// buffered data is thrown away when the link hiccups. A small state machine
+// tracks whether we are locked onto the frame boundary (Synced) or scanning
+// for the next 0xA3 sync byte (Hunting). The scan uses memchr(), which libc
+// implements with SSE2/AVX2 on x86 and NEON on ARM.
+class EcuMasterFrameDecoder {
+  public:
+    static constexpr quint8  kIdChar   = 0xA3;
+    static constexpr quint32 kFrameLen = 5;
+    static constexpr quint32 kCapacity = 4096; // must be a power of two
+
+    enum class State : quint8 { Hunting, Synced };
+
+    struct Frame {
+        quint8 ch;
+        quint8 vh;
+        quint8 vl;
+        quint8 cs;
+        bool   mod255; // checksum matched the legacy % 255 variant
+    };
+
+    struct Stats {
+        quint64 bytesIn          = 0;
+        quint64 frames           = 0;
+        quint64 frames255        = 0; // subset of frames accepted via % 255
+        quint64 checksumFailures = 0; // 0xA3 in place but neither checksum matched
+        quint64 resyncs          = 0; // lost lock while Synced
+        quint64 bytesDiscarded   = 0;
+    };
+
+    void reset() {
+        m_head  = 0;
+        m_tail  = 0;
+        m_state = State::Hunting;
+        m_stats = Stats{};
+    }
+
+    State        state() const { return m_state; }
+    const Stats &stats() const { return m_stats; }
+    quint32      buffered() const { return m_head - m_tail; }
+
+    // Append `len` bytes and call onFrame(const Frame&) for every complete
+    // frame. Returns the number of frames decoded.
+    template <typename Fn> int feed(const char *data, qsizetype len, Fn &&onFrame) {
+        int decoded = 0;
+        while (len > 0) {
+            const quint32 n = quint32(qMin<qsizetype>(len, kCapacity - buffered()));
+            write(reinterpret_cast<const quint8 *>(data), n);
+            data += n;
+            len -= n;
+            m_stats.bytesIn += n;
+            decoded += drain(onFrame);
+        }
+        return decoded;
+    }
+
+  private:
+    static constexpr quint32 kMask = kCapacity - 1;
+    static_assert((kCapacity & kMask) == 0, "ring capacity must be a power of two");
+
+    quint8 at(quint32 i) const { return m_ring[i & kMask]; }
+
+    void write(const quint8 *src, quint32 n) {
+        const quint32 off   = m_head & kMask;
+        const quint32 first = qMin(n, kCapacity - off);
+        std::memcpy(m_ring + off, src, first);
+        std::memcpy(m_ring, src + first, n - first);
+        m_head += n;
+    }
+
+    void discard(quint32 n) {
+        m_tail += n;
+        m_stats.bytesDiscarded += n;
+    }
+
+    // Index (monotonic) of the next sync byte in [from, m_head), or m_head.
+    quint32 findIdChar(quint32 from) const {
+        while (from != m_head) {
+            const quint32 off = from & kMask;
+            const quint32 run = qMin(m_head - from, kCapacity - off);
+            const void   *hit = std::memchr(m_ring + off, kIdChar, run);
+            if (hit)
+                return from + quint32(static_cast<const quint8 *>(hit) - (m_ring + off));
+            from += run;
+        }
+        return m_head;
+    }
+
+    template <typename Fn> int drain(Fn &onFrame) {
+        int decoded = 0;
+        while (buffered() >= kFrameLen) {
+            if (m_state == State::Hunting) {
+                const quint32 id = findIdChar(m_tail + 1);
+                if (id == m_head) {
+                    // keep the last byte: it may be the channel of a frame
+                    // whose sync byte has not arrived yet
+                    discard(buffered() - 1);
+                    break;
+                }
+                discard(id - 1 - m_tail);
+                if (buffered() < kFrameLen)
+                    break;
+            }
+
+            Frame       f{at(m_tail), at(m_tail + 2), at(m_tail + 3), at(m_tail + 4), false};
+            const bool  sync = at(m_tail + 1) == kIdChar;
+            const int   sum  = int(f.ch) + int(kIdChar) + int(f.vh) + int(f.vl);
+            const bool  ok256 = sync && (sum & 0xFF) == f.cs;
+            const bool  ok255 = sync && !ok256 && (sum % 255) == f.cs;
+
+            if (!ok256 && !ok255) {
+                if (sync)
+                    ++m_stats.checksumFailures;
+                if (m_state == State::Synced) {
+                    ++m_stats.resyncs;
+                    m_state = State::Hunting;
+                }
+                discard(1);
+                continue;
+            }
+
+            m_tail += kFrameLen;
+            m_state = State::Synced;
+            ++m_stats.frames;
+            if (ok255)
+                ++m_stats.frames255;
+            f.mod255 = ok255;
+            onFrame(static_cast<const Frame &>(f));
+            ++decoded;
+        }
+        return decoded;
+    }
+
+    quint32 m_head  = 0; // write position (monotonic, wraps with quint32)
+    quint32 m_tail  = 0; // read position
+    State   m_state = State::Hunting;
+    Stats   m_stats;
+    quint8  m_ring[kCapacity];
+};
@@ -1,92 +1,287 @@
 #include "obd2_elm327.h"
-#include "transports/serial_transport.h"
+#include "core/itransport.h"
 #include <QDateTime>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <limits>
 
-OBD2Elm327Protocol::OBD2Elm327Protocol(QObject *parent) : IECUProtocol(parent) {
-    connect(&m_poll, &QTimer::timeout, this, &OBD2Elm327Protocol::pollOnce);
-    m_poll.setInterval(100); // ~10 Hz total across a few PIDs
+OBD2Elm327Protocol::OBD2Elm327Protocol(QObject *parent)
+    : IECUProtocol(parent), m_timeout(this), m_idle(this), m_statsTimer(this) {
+    m_timeout.setSingleShot(true);
+    m_idle.setSingleShot(true);
+    m_statsTimer.setInterval(kStatsPeriodMs);
+    connect(&m_timeout, &QTimer::timeout, this, &OBD2Elm327Protocol::onTimeout);
+    connect(&m_idle, &QTimer::timeout, this, &OBD2Elm327Protocol::sendNext);
+    connect(&m_statsTimer, &QTimer::timeout, this, &OBD2Elm327Protocol::publishStats);
+
+    // Fast channels ride on every request, slow ones only when due.
+    m_pids = {
+        {0x0C, Sig::EngineRpm,        0},    // RPM = ((A*256)+B)/4
+        {0x0B, Sig::EngineMapKpa,     0},    // MAP = A (kPa)
+        {0x11, Sig::EngineTpsPercent, 100},  // TPS = A*100/255
+        {0x0D, Sig::VehicleSpeedKph,  200},  // Speed = A (km/h)
+        {0x05, Sig::TempsCltC,        2000}, // Coolant temp = A-40 (C)
+        {0x0F, Sig::TempsIatC,        2000}, // IAT = A-40
+    };
+    auto &metrics = PipelineMetrics::instance();
+    for (PidSched &p : m_pids) {
+        const QString pid = QString::number(p.pid, 16).rightJustified(2, '0').toUpper();
+        p.samples = metrics.counter(QStringLiteral("obd2.pid.%1.samples").arg(pid));
+        p.rateMHz = metrics.gauge(QStringLiteral("obd2.pid.%1.mHz").arg(pid));
+    }
+    m_clock.start();
 }
 
 bool OBD2Elm327Protocol::probe(ITransport *t) {
-    m_st = qobject_cast<SerialTransport*>(t);
+    m_st = (t && t->kind() == ITransport::Kind::ByteStream) ? t : nullptr;
     if (!m_st) return false;
     connect(m_st, &ITransport::bytesIn, this, &OBD2Elm327Protocol::onSerial, Qt::UniqueConnection);
     m_rxBuf.clear();
-    send("ATZ\r");     // reset
-    send("ATI\r");     // identify
-    // naive probe: we'll look for "ELM" substring in responses we collect in onSerial()
+    m_atQueue.clear();
+    m_busy = false;
+    m_stale = false;
+    send("ATZ\r", kAtTimeoutMs); // reset (replies with banner + '>')
+    m_atQueue << "ATI\r";        // identify
     return true; // allow start(); you can gate this tighter if you want
 }
 
 bool OBD2Elm327Protocol::start(ITransport *t) {
-    m_st = qobject_cast<SerialTransport*>(t);
+    m_st = (t && t->kind() == ITransport::Kind::ByteStream) ? t : nullptr;
     if (!m_st || !m_st->isOpen()) return false;
 
-    send("ATE0\r"); // echo off
-    send("ATL0\r"); // linefeeds off
-    send("ATS0\r"); // spaces off
-    send("ATH0\r"); // headers off
-    send("ATSP0\r"); // auto protocol
+    m_atQueue << "ATE0\r"   // echo off
+              << "ATL0\r"   // linefeeds off
+              << "ATS0\r"   // spaces off
+              << "ATH0\r"   // headers off
+              << "ATSP0\r"; // auto protocol
 
-    m_poll.start();
+    m_multi = MultiPid::Unknown;
+    m_singleAnswers = 0;
+    m_gotData = false;
+    for (PidSched &p : m_pids) { p.dueMs = 0; p.windowSamples = 0; }
+    m_polling = true;
+    m_statsTimer.start();
+    sendNext();
     emit statusChanged("Polling OBD-II PIDs");
     return true;
 }
 
 void OBD2Elm327Protocol::stop() {
-    m_poll.stop();
+    m_polling = false;
+    m_stale = false;
+    m_timeout.stop();
+    m_idle.stop();
+    m_statsTimer.stop();
 }
 
-void OBD2Elm327Protocol::send(const QByteArray &cmd) {
-    if (m_st) m_st->write(cmd);
+void OBD2Elm327Protocol::send(const QByteArray &cmd, int timeoutMs) {
+    if (!m_st) return;
+    m_st->write(cmd);
+    m_busy = true;
+    m_sentAtNs = m_clock.nsecsElapsed();
+    m_timeout.start(timeoutMs);
+}
+
+void OBD2Elm327Protocol::sendNext() {
+    if (m_busy || !m_st) return;
+    if (!m_atQueue.isEmpty()) {
+        send(m_atQueue.takeFirst(), kAtTimeoutMs);
+        return;
+    }
+    if (!m_polling) return;
+
+    // Due PIDs, most overdue first
+    const qint64 now = m_clock.elapsed();
+    QVarLengthArray<int, 8> due;
+    qint64 nextDue = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < m_pids.size(); ++i) {
+        if (m_pids[i].dueMs <= now) due.append(i);
+        else nextDue = qMin(nextDue, m_pids[i].dueMs);
+    }
+    if (due.isEmpty()) {
+        m_idle.start(int(qMax<qint64>(1, nextDue - now)));
+        return;
+    }
+    std::sort(due.begin(), due.end(), [this](int a, int b) { return m_pids[a].dueMs < m_pids[b].dueMs; });
+
+    const int maxPids = (m_multi == MultiPid::No) ? 1 : kMaxPidsPerRequest;
+    const int n = qMin(int(due.size()), maxPids);
+    QByteArray cmd("01");
+    m_inFlight.clear();
+    for (int k = 0; k < n; ++k) {
+        PidSched &p = m_pids[due[k]];
+        cmd += QByteArray::number(p.pid, 16).rightJustified(2, '0').toUpper();
+        p.dueMs = now + p.periodMs;
+        m_inFlight.append(due[k]);
+    }
+    cmd += '\r';
+    send(cmd, m_gotData ? kPidTimeoutMs : kSearchTimeoutMs);
 }
 
 void OBD2Elm327Protocol::onSerial(const QByteArray &buf) {
     m_rxBuf += buf;
-    // Split on '>' prompt or CR
+    // Everything up to the '>' prompt is the response to the last command
     int idx;
-    while ((idx = m_rxBuf.indexOf('\r')) >= 0) {
-        const QByteArray line = m_rxBuf.left(idx);
-        m_rxBuf.remove(0, idx+1);
-        QString pid; int val = 0;
-        if (parseLine(line, pid, val)) {
-            const qint64 now = QDateTime::currentMSecsSinceEpoch();
-            if (pid == "0C") { // RPM = ((A*256)+B)/4
-                emit sig({"Engine.RPM", val/4.0, now});
-            } else if (pid == "0D") { // Speed = A (km/h)
-                emit sig({"Vehicle.SpeedKph", double(val), now});
-            } else if (pid == "05") { // Coolant temp = A-40 (C)
-                emit sig({"Temps.CLT_C", double(val-40), now});
-            } else if (pid == "0F") { // IAT = A-40
-                emit sig({"Temps.IAT_C", double(val-40), now});
-            } else if (pid == "11") { // TPS = A*100/255
-                emit sig({"Engine.TPS_Percent", (val*100.0)/255.0, now});
-            } else if (pid == "0B") { // MAP = A (kPa) approx
-                emit sig({"Engine.MAP_kPa", double(val), now});
+    while ((idx = m_rxBuf.indexOf('>')) >= 0) {
+        const QByteArray resp = m_rxBuf.left(idx);
+        m_rxBuf.remove(0, idx + 1);
+        onResponse(resp);
+    }
+    if (m_rxBuf.size() > kMaxRxBytes)
+        m_rxBuf.clear();
+}
+
+void OBD2Elm327Protocol::onResponse(const QByteArray &resp) {
+    m_timeout.stop();
+    if (m_stale) {
+        // Late prompt of the command that timed out ("STOPPED" or its
+        // answer): the adapter is idle again, the payload is dropped
+        m_stale = false;
+        m_busy = false;
+        m_mStale->add();
+        sendNext();
+        return;
+    }
+    if (m_busy && !m_inFlight.isEmpty()) {
+        m_mRequests->add();
+        m_mRtt->record((m_clock.nsecsElapsed() - m_sentAtNs) / 1000);
+    }
+    m_busy = false;
+
+    if (!m_inFlight.isEmpty()) {
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        const QList<QByteArray> lines = resp.split('\r');
+
+        // Multi-frame (ISO-TP) answers come as "0:..", "1:.." segments of
+        // one message; plain answers are one message per line (per ECU).
+        PidValue vals[16];
+        int got = 0;
+        bool isoTp = false;
+        for (const QByteArray &l : lines)
+            isoTp = isoTp || l.contains(':');
+        if (isoTp) {
+            QByteArray joined;
+            for (const QByteArray &l : lines) {
+                const int c = l.indexOf(':');
+                if (c >= 0) joined += l.mid(c + 1);
             }
+            got = parseLine(joined, vals, 16);
+        } else {
+            for (const QByteArray &l : lines)
+                got += parseLine(l, vals + got, 16 - got);
+        }
+
+        for (int i = 0; i < got; ++i)
+            emitPid(vals[i].pid, vals[i].value, now);
+        if (got > 0) m_gotData = true;
+
+        // Packed answers decide whether packing works on this car: two or
+        // more values is a yes. No values ("NO DATA", "SEARCHING...",
+        // "UNABLE TO CONNECT" with the engine off) says nothing, and one
+        // value may just be the only supported PID of the pack, so packing
+        // is given up only after kMultiPidProbes of those.
+        if (m_multi == MultiPid::Unknown && m_inFlight.size() > 1 && got > 0) {
+            if (got >= 2) m_multi = MultiPid::Yes;
+            else if (++m_singleAnswers >= kMultiPidProbes) m_multi = MultiPid::No;
+            if (m_multi != MultiPid::Unknown)
+                emit statusChanged(m_multi == MultiPid::Yes ? "Polling OBD-II PIDs (multi-PID requests)"
+                                                            : "Polling OBD-II PIDs (one PID per request)");
         }
+
+        m_inFlight.clear();
+        flush();
     }
+    sendNext();
 }
 
-bool OBD2Elm327Protocol::parseLine(const QByteArray &line, QString &pid, int &value) {
-    // Expect like: "41 0C 1A F8" → mode 01 response (0x41), PID 0C, then A B
-    QList<QByteArray> tok = line.simplified().split(' ');
-    if (tok.size() < 3) return false;
-    if (tok[0] != "41") return false;
-    pid = QString::fromLatin1(tok[1]);
-    value = 0;
-    for (int i=2;i<tok.size();++i) {
-        bool ok=false; int b = tok[i].toInt(&ok, 16);
-        if (!ok) return false;
-        value = (value<<8) | (b & 0xFF);
+void OBD2Elm327Protocol::onTimeout() {
+    if (!m_stale) {
+        // The adapter may still be working on it, and any byte sent now would
+        // abort it: wait once more for its '>' before sending again
+        if (!m_inFlight.isEmpty()) {
+            m_mTimeouts->add();
+            if (m_multi == MultiPid::Unknown && m_inFlight.size() > 1 && m_gotData) {
+                m_multi = MultiPid::No;
+                emit statusChanged("Polling OBD-II PIDs (one PID per request)");
+            }
+            m_inFlight.clear();
+        }
+        m_stale = true;
+        m_timeout.start(kPidTimeoutMs);
+        return;
     }
-    return true;
+    // No prompt at all: assume it was lost and resync on the next one
+    m_stale = false;
+    m_busy = false;
+    m_rxBuf.clear();
+    sendNext();
 }
 
-void OBD2Elm327Protocol::pollOnce() {
-    // rotate through a few core PIDs
-    static int step = 0;
-    const char* pids[] = { "010C", "010D", "0105", "010F", "0111", "010B" };
-    send(QByteArray(pids[step]) + "\r");
-    step = (step+1) % 6;
+void OBD2Elm327Protocol::emitPid(quint8 pid, quint32 val, qint64 now) {
+    for (PidSched &p : m_pids) {
+        if (p.pid != pid) continue;
+        ++p.windowSamples;
+        p.samples->add();
+        switch (pid) {
+        case 0x0C: push(p.id, val / 4.0, now); break;
+        case 0x05:
+        case 0x0F: push(p.id, double(int(val) - 40), now); break;
+        case 0x11: push(p.id, (val * 100.0) / 255.0, now); break;
+        default:   push(p.id, double(val), now); break; // 0B MAP, 0D speed
+        }
+        return;
+    }
+}
+
+void OBD2Elm327Protocol::publishStats() {
+    for (PidSched &p : m_pids) {
+        p.rateMHz->set(qint64(p.windowSamples) * 1000 * 1000 / kStatsPeriodMs);
+        p.windowSamples = 0;
+    }
+}
+
+int OBD2Elm327Protocol::pidDataBytes(quint8 pid) {
+    switch (pid) {
+    case 0x04: case 0x05: case 0x0B: case 0x0D: case 0x0E:
+    case 0x0F: case 0x11: case 0x2F: case 0x33: case 0x46:
+        return 1;
+    case 0x0C: case 0x10: case 0x1F: case 0x42: case 0x44:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+int OBD2Elm327Protocol::parseLine(const QByteArray &line, PidValue *out, int max) {
+    // Expect like: "41 0C 1A F8 0D 32" → mode 01 response (0x41), then
+    // PID + data bytes, repeated for packed requests
+    quint8 bytes[64];
+    int nb = 0, nibbles = 0, cur = 0;
+    for (const char c : line) {
+        int v;
+        if (c >= '0' && c <= '9') v = c - '0';
+        else if (c >= 'A' && c <= 'F') v = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f') v = c - 'a' + 10;
+        else if (c == ' ') continue;
+        else return 0; // "NO DATA", "SEARCHING...", echo etc.
+        cur = (cur << 4) | v;
+        if (++nibbles % 2 == 0) {
+            if (nb == int(sizeof(bytes))) break;
+            bytes[nb++] = quint8(cur);
+            cur = 0;
+        }
+    }
+    if (nibbles % 2 != 0 || nb < 3 || bytes[0] != 0x41) return 0;
+
+    int count = 0;
+    for (int i = 1; i < nb && count < max;) {
+        const int len = pidDataBytes(bytes[i]);
+        if (len == 0 || i + 1 + len > nb) break; // unknown PID or ISO-TP padding
+        quint32 value = 0;
+        for (int k = 0; k < len; ++k)
+            value = (value << 8) | bytes[i + 1 + k];
+        out[count++] = {bytes[i], value};
+        i += 1 + len;
+    }
+    return count;
 }
@@ -1,31 +1,97 @@
 #pragma once
 #include "core/iecuprotocol.h"
+#include "core/pipeline_metrics.h"
+#include <QElapsedTimer>
 #include <QObject>
 #include <QTimer>
+#include <QVector>
 
-class SerialTransport;
+class ITransport;
 
+// OBD-II over an ELM327 adapter.
+//
+// Requests are prompt-driven: a command is only sent after the adapter's
+// '>' prompt for the previous one came back. Each PID has its own polling
+// period (RPM/MAP every request, CLT/IAT every couple of seconds); all due
+// PIDs are packed into one mode-01 request ("010C0B11\r") when the adapter
+// and ECU answer multi-PID requests, otherwise it falls back to one PID per
+// request. After a timeout nothing is sent until the late '>' of the timed
+// out command arrived (or a second deadline passed), so a stale prompt is
+// never taken as the answer to the next request.
+//
+// Request round-trip time goes to the "obd2.rttUs" histogram; every PID
+// counts its samples in "obd2.pid.<PID>.samples" and the rate achieved over
+// the last few seconds is kept in the "obd2.pid.<PID>.mHz" gauge.
 class OBD2Elm327Protocol : public IECUProtocol {
     Q_OBJECT
   public:
     explicit OBD2Elm327Protocol(QObject *parent=nullptr);
     QString name() const override { return "OBD2/ELM327"; }
 
-    bool probe(ITransport *t) override;  // send "ATZ" and expect "ELM"
-    bool start(ITransport *t) override;  // set up periodic PID polling
+    bool probe(ITransport *t) override;  // reset + identify the adapter
+    bool start(ITransport *t) override;  // configure, then start the scheduler
     void stop() override;
 
+    struct PidValue {
+        quint8  pid;
+        quint32 value; // data bytes, big-endian (A*256+B for 2-byte PIDs)
+    };
+
+           // Parse one mode-01 response ("41 0C 1A F8 0D 32" or "410C1AF80D32",
+           // one or more PIDs). Returns the number of values written to out.
+    static int parseLine(const QByteArray &line, PidValue *out, int max);
+    static int pidDataBytes(quint8 pid); // 0 = unknown PID
+
   private:
-    SerialTransport *m_st{nullptr};
-    QTimer m_poll;
+    struct PidSched {
+        quint8   pid;
+        SignalId id;
+        int      periodMs;           // 0 = every request
+        qint64   dueMs{0};           // next request time (m_clock)
+        quint32  windowSamples{0};   // samples since last stats publish
+        PipelineMetrics::Counter *samples{nullptr};
+        PipelineMetrics::Gauge   *rateMHz{nullptr};
+    };
+    enum class MultiPid : quint8 { Unknown, Yes, No };
+
+    static constexpr int kMaxPidsPerRequest = 6;
+    static constexpr int kAtTimeoutMs       = 3000; // ATZ takes ~1 s
+    static constexpr int kSearchTimeoutMs   = 8000; // first request: ATSP0 search
+    static constexpr int kPidTimeoutMs      = 1000;
+    static constexpr int kStatsPeriodMs     = 5000;
+    static constexpr int kMaxRxBytes        = 4096; // no '>' by then: line noise
+    static constexpr int kMultiPidProbes    = 3;    // one-value packed answers before packing is off
+
+    ITransport *m_st{nullptr}; // any byte-stream transport (serial, replay)
+    QTimer m_timeout;     // no '>' within the deadline
+    QTimer m_idle;        // nothing due yet: wake at the next deadline
+    QTimer m_statsTimer;
+    QElapsedTimer m_clock;
     QByteArray m_rxBuf;
 
-    void send(const QByteArray &cmd);
-    void pollOnce();
+    QList<QByteArray> m_atQueue;  // AT commands to send before polling
+    QVector<PidSched> m_pids;
+    QVector<int> m_inFlight;      // m_pids indices in the outstanding request
+    MultiPid m_multi{MultiPid::Unknown};
+    int m_singleAnswers{0};       // packed requests answered with one value
+    bool m_busy{false};           // request sent, waiting for '>'
+    bool m_stale{false};          // timed out: next '>' belongs to the old command
+    bool m_polling{false};
+    bool m_gotData{false};        // protocol search finished
+    qint64 m_sentAtNs{0};
+
+    PipelineMetrics::Histogram *m_mRtt      = PipelineMetrics::instance().histogram("obd2.rttUs");
+    PipelineMetrics::Counter   *m_mRequests = PipelineMetrics::instance().counter("obd2.requests");
+    PipelineMetrics::Counter   *m_mTimeouts = PipelineMetrics::instance().counter("obd2.timeouts");
+    PipelineMetrics::Counter   *m_mStale    = PipelineMetrics::instance().counter("obd2.staleResponses");
+
+    void send(const QByteArray &cmd, int timeoutMs);
+    void sendNext();
+    void onResponse(const QByteArray &resp);
+    void onTimeout();
+    void publishStats();
+    void emitPid(quint8 pid, quint32 value, qint64 now);
 
   private slots:
     void onSerial(const QByteArray &buf);
-
-           // helpers
-    bool parseLine(const QByteArray &line, QString &pid, int &value);
 };
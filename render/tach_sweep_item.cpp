@@ -0,0 +1,110 @@
+#include "tach_sweep_item.h"
+#include "tinted_image_provider.h"
+
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QSGTexture>
+
+TachSweepItem::TachSweepItem(QQuickItem *parent) : QQuickItem(parent) {
+    setFlag(ItemHasContents, true);
+}
+
+void TachSweepItem::setSource(const QUrl &u) {
+    if (u == m_source) return;
+    m_source = u;
+    invalidateImage();
+    emit sourceChanged();
+}
+
+void TachSweepItem::setFraction(qreal f) {
+    f = qBound<qreal>(0.0, f, 1.0);
+    if (qFuzzyCompare(f + 1.0, m_fraction + 1.0)) return;
+    m_fraction = f;
+    update();
+    emit fractionChanged();
+}
+
+void TachSweepItem::setTinted(bool on) {
+    if (on == m_tinted) return;
+    m_tinted = on;
+    invalidateImage();
+    emit tintChanged();
+}
+
+void TachSweepItem::setStartColor(const QColor &c) {
+    if (c == m_start) return;
+    m_start = c;
+    if (m_tinted) invalidateImage();
+    emit tintChanged();
+}
+
+void TachSweepItem::setEndColor(const QColor &c) {
+    if (c == m_end) return;
+    m_end = c;
+    if (m_tinted) invalidateImage();
+    emit tintChanged();
+}
+
+void TachSweepItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) {
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size())
+        invalidateImage();
+}
+
+void TachSweepItem::invalidateImage() {
+    m_imageDirty = true;
+    update();
+}
+
+QImage TachSweepItem::renderImage() const {
+    QString path = m_source.toString();
+    if (m_source.scheme() == QLatin1String("qrc"))
+        path = QLatin1Char(':') + m_source.path();
+    else if (m_source.isLocalFile())
+        path = m_source.toLocalFile();
+
+    QImage img(path);
+    if (img.isNull()) {
+        qWarning("TachSweepItem: cannot load %s", qPrintable(m_source.toString()));
+        return {};
+    }
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    const QSize px = (size() * dpr).toSize();
+    if (!px.isEmpty() && img.size() != px)
+        img = img.scaled(px, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    img = img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (m_tinted)
+        TintedImageProvider::tint(&img, m_start, m_end);
+    return img;
+}
+
+QSGNode *TachSweepItem::updatePaintNode(QSGNode *old, UpdatePaintNodeData *) {
+    auto *node = static_cast<QSGImageNode *>(old);
+    if (width() <= 0 || height() <= 0 || m_source.isEmpty()) {
+        delete node;
+        m_imageDirty = true;
+        return nullptr;
+    }
+
+    if (!node || m_imageDirty) {
+        const QImage img = renderImage();
+        if (img.isNull()) {
+            delete node;
+            return nullptr;
+        }
+        if (!node) {
+            node = window()->createImageNode();
+            node->setOwnsTexture(true);
+            node->setFiltering(QSGTexture::Linear);
+        }
+        node->setTexture(window()->createTextureFromImage(img));
+        m_imageDirty = false;
+    }
+
+    // Per-update work: one quad's position and texture coordinates
+    const QSizeF tex = node->texture()->textureSize();
+    const qreal  f = m_fraction;
+    node->setRect(QRectF(0, 0, width() * f, height()));
+    node->setSourceRect(QRectF(0, 0, tex.width() * f, tex.height()));
+    return node;
+}
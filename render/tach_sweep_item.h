@@ -0,0 +1,55 @@
+#pragma once
+#include <QColor>
+#include <QImage>
+#include <QQuickItem>
+#include <QUrl>
+
+// Tachometer sweep drawn straight into the scene graph.
+//
+// The (optionally gradient-tinted) scale image is rendered and uploaded as
+// a texture once per source/size/colour change. Moving the sweep only
+// rewrites the node's rect and source rect, i.e. the four vertices of one
+// textured quad, so an RPM update costs no layout, clipping or JS paint.
+// Uses QSGImageNode, which every backend (incl. software) implements.
+class TachSweepItem : public QQuickItem {
+    Q_OBJECT
+    Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(qreal fraction READ fraction WRITE setFraction NOTIFY fractionChanged)
+    Q_PROPERTY(bool tinted READ tinted WRITE setTinted NOTIFY tintChanged)
+    Q_PROPERTY(QColor startColor READ startColor WRITE setStartColor NOTIFY tintChanged)
+    Q_PROPERTY(QColor endColor READ endColor WRITE setEndColor NOTIFY tintChanged)
+
+  public:
+    explicit TachSweepItem(QQuickItem *parent=nullptr);
+
+    QUrl   source() const { return m_source; }
+    void   setSource(const QUrl &u);
+    qreal  fraction() const { return m_fraction; } // revealed share of the width, 0..1
+    void   setFraction(qreal f);
+    bool   tinted() const { return m_tinted; }
+    void   setTinted(bool on);
+    QColor startColor() const { return m_start; }
+    void   setStartColor(const QColor &c);
+    QColor endColor() const { return m_end; }
+    void   setEndColor(const QColor &c);
+
+  signals:
+    void sourceChanged();
+    void fractionChanged();
+    void tintChanged();
+
+  protected:
+    QSGNode *updatePaintNode(QSGNode *old, UpdatePaintNodeData *) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+  private:
+    void invalidateImage();
+    QImage renderImage() const;
+
+    QUrl   m_source;
+    qreal  m_fraction{0.0};
+    bool   m_tinted{true};
+    QColor m_start{Qt::white};
+    QColor m_end{Qt::red};
+    bool   m_imageDirty{true};
+};
@@ -0,0 +1,112 @@
+#include "tinted_image_provider.h"
+
+#include <QLinearGradient>
+#include <QMutexLocker>
+#include <QPainter>
+
+namespace {
+QString hex(const QColor &c) { return c.name(QColor::HexArgb).mid(1); }
+QColor  fromHex(QStringView s) { return QColor::fromString(QStringLiteral("#") + s); }
+}
+
+TintedImageProvider::TintedImageProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image) {
+    m_tinted.setMaxCost(kCacheKb);
+    m_sources.setMaxCost(kCacheKb / 4);
+}
+
+QString TintedImageProvider::resourcePath(const QString &asset) {
+    if (asset.startsWith(QLatin1String("qrc:/"))) return asset.mid(5);
+    if (asset.startsWith(QLatin1String(":/")))    return asset.mid(2);
+    return asset;
+}
+
+QString TintedImageProvider::url(const QString &asset, const QColor &tint) const {
+    if (asset.isEmpty()) return {};
+    return QStringLiteral("image://%1/s/%2/%3").arg(QLatin1String(kId), hex(tint), resourcePath(asset));
+}
+
+QString TintedImageProvider::gradientUrl(const QString &asset, const QColor &start, const QColor &end) const {
+    if (asset.isEmpty()) return {};
+    return QStringLiteral("image://%1/g/%2-%3/%4")
+        .arg(QLatin1String(kId), hex(start), hex(end), resourcePath(asset));
+}
+
+QImage TintedImageProvider::source(const QString &path, const QSize &size) {
+    const QString key = path + QLatin1Char('@') + QString::number(size.width())
+                        + QLatin1Char('x') + QString::number(size.height());
+    if (const QImage *hit = m_sources.object(key)) return *hit;
+
+    QImage img(QStringLiteral(":/") + path);
+    if (img.isNull()) return {};
+    if (size.isValid() && img.size() != size)
+        img = img.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    img = img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    m_sources.insert(key, new QImage(img), costKb(img));
+    return img;
+}
+
+QImage TintedImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize) {
+    // "<mode>/<colours>/<path>"; path may itself contain '/'
+    const int s1 = id.indexOf(QLatin1Char('/'));
+    const int s2 = s1 < 0 ? -1 : id.indexOf(QLatin1Char('/'), s1 + 1);
+    if (s1 != 1 || s2 < 0) {
+        qWarning("TintedImageProvider: bad id %s", qPrintable(id));
+        return {};
+    }
+    const QChar mode = id.at(0);
+    const QStringView colours = QStringView(id).mid(s1 + 1, s2 - s1 - 1);
+    const QString path = id.mid(s2 + 1);
+
+    // Either dimension <= 0 keeps the asset's native size
+    const QSize want = (requestedSize.width() > 0 && requestedSize.height() > 0) ? requestedSize : QSize();
+    const QString key = id + QLatin1Char('@') + QString::number(want.width())
+                        + QLatin1Char('x') + QString::number(want.height());
+
+    QMutexLocker lock(&m_mutex);
+    if (const QImage *hit = m_tinted.object(key)) {
+        ++m_hits;
+        if (size) *size = hit->size();
+        return *hit;
+    }
+    ++m_misses;
+
+    QImage out = source(path, want);
+    if (out.isNull()) {
+        qWarning("TintedImageProvider: cannot load :/%s", qPrintable(path));
+        return {};
+    }
+    if (mode == QLatin1Char('g')) {
+        const int dash = colours.indexOf(QLatin1Char('-'));
+        tint(&out, fromHex(colours.left(dash)), fromHex(colours.mid(dash + 1)));
+    } else {
+        const QColor c = fromHex(colours);
+        tint(&out, c, c);
+    }
+
+    m_tinted.insert(key, new QImage(out), costKb(out));
+    if (size) *size = out.size();
+    return out;
+}
+
+void TintedImageProvider::tint(QImage *img, const QColor &start, const QColor &end) {
+    QPainter p(img);
+    p.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    if (start == end) {
+        p.fillRect(img->rect(), start);
+    } else {
+        QLinearGradient g(0, 0, img->width(), 0);
+        g.setColorAt(0.0, start);
+        g.setColorAt(1.0, end);
+        p.fillRect(img->rect(), g);
+    }
+}
+
+QVariantMap TintedImageProvider::stats() const {
+    QMutexLocker lock(&m_mutex);
+    QVariantMap m;
+    m.insert("hits", double(m_hits));
+    m.insert("misses", double(m_misses));
+    m.insert("cachedKb", m_tinted.totalCost() + m_sources.totalCost());
+    return m;
+}
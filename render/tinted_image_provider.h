@@ -0,0 +1,50 @@
+#pragma once
+#include <QCache>
+#include <QColor>
+#include <QImage>
+#include <QMutex>
+#include <QQuickImageProvider>
+#include <QVariantMap>
+
+// Tinted variants of the monochrome dash assets (frame, tach scale, metric
+// icons), rendered once per (asset, colour(s), size) and served to QML as
+// plain Image sources:
+//
+//   image://tinted/s/<AARRGGBB>/<resource path>            solid tint
+//   image://tinted/g/<AARRGGBB>-<AARRGGBB>/<resource path> left→right gradient
+//
+// The asset's alpha is kept and its colour replaced (the Canvas "source-in"
+// fill the pages used to do per repaint). Build URLs with url()/gradientUrl()
+// rather than by hand; Image.sourceSize selects the rendered size. Results
+// live in an LRU cache bounded by kCacheKb, so flipping between themes does
+// not re-render. requestImage() may run on QML's loader threads.
+class TintedImageProvider : public QQuickImageProvider {
+    Q_OBJECT
+
+  public:
+    static constexpr const char *kId = "tinted";
+    static constexpr int kCacheKb = 32 * 1024;
+
+    TintedImageProvider();
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+    Q_INVOKABLE QString url(const QString &asset, const QColor &tint) const;
+    Q_INVOKABLE QString gradientUrl(const QString &asset, const QColor &start, const QColor &end) const;
+    Q_INVOKABLE QVariantMap stats() const; // hits, misses, cachedKb
+
+    // Replace the colour of `img` (ARGB32_Premultiplied) with a left→right
+    // start→end gradient, keeping its alpha. start == end is a solid tint.
+    static void tint(QImage *img, const QColor &start, const QColor &end);
+
+  private:
+    QImage source(const QString &path, const QSize &size); // scaled, unpainted asset
+    static QString resourcePath(const QString &asset);
+    static int costKb(const QImage &img) { return int(qMax<qsizetype>(1, img.sizeInBytes() / 1024)); }
+
+    mutable QMutex m_mutex;
+    QCache<QString, QImage> m_tinted;
+    QCache<QString, QImage> m_sources; // decoded + scaled assets, reused across colours
+    quint64 m_hits{0};
+    quint64 m_misses{0};
+};
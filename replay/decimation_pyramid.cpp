@@ -0,0 +1,110 @@
+#include "decimation_pyramid.h"
+
+void DecimationPyramid::extend(const QVector<float> &col) {
+    if (m_levels.isEmpty()) {
+        Level l0;
+        l0.span = kFanout;
+        m_levels.append(l0);
+    }
+
+    // Level 0 from raw rows (complete buckets only; the tail is read raw)
+    {
+        Level &l = m_levels[0];
+        const int done = l.min.size();
+        const int full = col.size() / kFanout;
+        l.min.resize(full);
+        l.max.resize(full);
+        l.sum.resize(full);
+        l.count.resize(full);
+        const float *v = col.constData();
+        for (int b = done; b < full; ++b) {
+            const float *p = v + qsizetype(b) * kFanout;
+            float mn = qInf(), mx = -qInf();
+            float sum = 0.0f;
+            quint32 n = 0;
+            for (int i = 0; i < kFanout; ++i) {
+                const float x = p[i];
+                const bool ok = x == x; // not NaN
+                mn = x < mn ? x : mn;
+                mx = x > mx ? x : mx;
+                sum += ok ? x : 0.0f;
+                n += ok ? 1u : 0u;
+            }
+            l.min[b] = mn;
+            l.max[b] = mx;
+            l.sum[b] = sum;
+            l.count[b] = n;
+        }
+    }
+
+    // Higher levels from the level below
+    for (int li = 1;; ++li) {
+        const int below = m_levels[li - 1].min.size();
+        const int full = below / kFanout;
+        if (full == 0) break;
+        if (li == m_levels.size()) {
+            Level l;
+            l.span = m_levels[li - 1].span * kFanout;
+            m_levels.append(l);
+        }
+        const Level &s = m_levels[li - 1];
+        Level &l = m_levels[li];
+        const int done = l.min.size();
+        l.min.resize(full);
+        l.max.resize(full);
+        l.sum.resize(full);
+        l.count.resize(full);
+        for (int b = done; b < full; ++b) {
+            const int o = b * kFanout;
+            float mn = qInf(), mx = -qInf();
+            double sum = 0.0;
+            quint32 n = 0;
+            for (int i = 0; i < kFanout; ++i) {
+                mn = s.min[o + i] < mn ? s.min[o + i] : mn;
+                mx = s.max[o + i] > mx ? s.max[o + i] : mx;
+                sum += s.sum[o + i];
+                n += s.count[o + i];
+            }
+            l.min[b] = mn;
+            l.max[b] = mx;
+            l.sum[b] = sum;
+            l.count[b] = n;
+        }
+    }
+}
+
+DecimationPyramid::Bucket DecimationPyramid::range(const QVector<float> &col, int first, int last) const {
+    Bucket r;
+    last = qMin(last, int(col.size()));
+    qint64 row = qMax(0, first);
+    while (row < last) {
+        // Largest bucket that starts at `row`, fits in the range and exists
+        int li = m_levels.size() - 1;
+        for (; li >= 0; --li) {
+            const Level &l = m_levels[li];
+            if (row % l.span == 0 && row + l.span <= last && row / l.span < l.min.size())
+                break;
+        }
+        if (li < 0) {
+            const float x = col[int(row)];
+            if (x == x) {
+                r.min = qMin(r.min, x);
+                r.max = qMax(r.max, x);
+                r.sum += x;
+                ++r.count;
+            }
+            ++row;
+            continue;
+        }
+        const Level &l = m_levels[li];
+        const int b = int(row / l.span);
+        if (l.count[b]) {
+            r.min = qMin(r.min, l.min[b]);
+            r.max = qMax(r.max, l.max[b]);
+            r.sum += l.sum[b];
+            r.count += l.count[b];
+        }
+        row += l.span;
+    }
+    return r;
+}
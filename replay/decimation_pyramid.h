@@ -0,0 +1,46 @@
+#pragma once
+#include <QVector>
+#include <QtNumeric>
+
+// Multi-resolution min/max/mean summary of one replay column.
+//
+// Level 0 summarizes kFanout consecutive rows per bucket, level L summarizes
+// kFanout buckets of level L-1. Buckets are stored as parallel arrays and
+// reduced with branch-free `a < b ? a : b` style loops that the compiler
+// turns into packed min/max (NaN rows, i.e. rows that did not log the
+// column, drop out of min/max for free and are masked out of the mean).
+//
+// range() answers min/max/mean for any row range by walking the largest
+// aligned buckets, segment-tree style, so its cost depends on the number of
+// levels and not on the number of rows.
+class DecimationPyramid {
+  public:
+    static constexpr int kFanout = 8;
+
+    struct Bucket {
+        float  min = qInf();
+        float  max = -qInf();
+        double sum = 0.0;
+        quint32 count = 0;
+
+        float mean() const { return count ? float(sum / count) : qQNaN(); }
+    };
+
+    void clear() { m_levels.clear(); }
+
+           // Summarize rows appended to `col` since the last call.
+    void extend(const QVector<float> &col);
+
+    Bucket range(const QVector<float> &col, int first, int last) const; // [first, last)
+
+  private:
+    struct Level {
+        qint64 span = 0;          // rows per bucket
+        QVector<float>   min;
+        QVector<float>   max;
+        QVector<double>  sum;
+        QVector<quint32> count;
+    };
+
+    QVector<Level> m_levels;
+};
@@ -0,0 +1,308 @@
+#include "log_replay_engine.h"
+#include "replay_log_loader.h"
+#include "dashmodel.h"
+#include <QThread>
+#include <algorithm>
+
+LogReplayEngine::LogReplayEngine(QObject *parent) : QObject(parent), m_tick(this) {
+    m_tick.setTimerType(Qt::PreciseTimer);
+    m_tick.setInterval(16); // ~60 Hz UI, independent of the log's sample rate
+    connect(&m_tick, &QTimer::timeout, this, &LogReplayEngine::onTick);
+    m_last.fill(qQNaN());
+}
+
+LogReplayEngine::~LogReplayEngine() {
+    if (m_cancel) m_cancel->store(true);
+    for (QThread *t : std::as_const(m_loaders))
+        t->wait();
+    // Their queued finished -> deleteLater never reaches a dying engine
+    qDeleteAll(m_loaders);
+}
+
+QObject *LogReplayEngine::target() const {
+    return m_dash.data();
+}
+
+void LogReplayEngine::setSourceUrl(const QUrl &u) {
+    if (u == m_source) return;
+    m_source = u;
+    emit sourceUrlChanged();
+}
+
+void LogReplayEngine::setTarget(QObject *t) {
+    DashModel *d = qobject_cast<DashModel *>(t);
+    if (d == m_dash) return;
+    m_dash = d;
+    emit targetChanged();
+}
+
+void LogReplayEngine::setLoop(bool on) {
+    if (on == m_loop) return;
+    m_loop = on;
+    emit loopChanged();
+}
+
+void LogReplayEngine::setSpeed(double s) {
+    s = qMax(0.0, s);
+    if (qFuzzyCompare(s, m_speed)) return;
+    rebase(); // keep the current position continuous across the change
+    m_speed = s;
+    emit speedChanged();
+}
+
+void LogReplayEngine::setPlaying(bool on) {
+    if (on && !frameCount()) {
+        m_playWhenLoaded = m_loading;
+        on = false;
+    }
+    if (on == m_playing) return;
+    m_playing = on;
+    if (on) {
+        rebase();
+        m_tick.start();
+    } else {
+        m_tick.stop();
+    }
+    emit playingChanged();
+}
+
+void LogReplayEngine::play() { setPlaying(true); }
+
+void LogReplayEngine::pause() {
+    m_playWhenLoaded = false;
+    setPlaying(false);
+}
+
+void LogReplayEngine::stop() {
+    pause();
+    seek(0);
+}
+
+void LogReplayEngine::cancelLoad() {
+    if (m_cancel) m_cancel->store(true);
+}
+
+void LogReplayEngine::clear() {
+    pause();
+    cancelLoad();
+    ++m_generation;
+    m_log = ReplayLog();
+    m_pyramids.clear();
+    m_index = 0;
+    m_position = 0;
+    m_last.fill(qQNaN());
+    setLoading(false);
+    emit durationChanged();
+    emit positionChanged();
+}
+
+void LogReplayEngine::load() {
+    if (m_source.isEmpty()) return;
+    clear();
+    setError(QString());
+
+    QString path = m_source.isLocalFile() ? m_source.toLocalFile() : m_source.toString();
+    if (m_source.scheme() == QLatin1String("qrc"))
+        path = QLatin1Char(':') + m_source.path();
+
+    const quint64 gen = ++m_generation;
+    m_cancel = std::make_shared<std::atomic<bool>>(false);
+    m_progress = 0.0;
+    emit loadProgressChanged();
+    setLoading(true);
+
+    QThread *t = QThread::create([this, path, gen, cancel = m_cancel] {
+        ReplayLogLoader loader(path, cancel.get());
+        QString err;
+        const bool ok = loader.run([this, gen](QSharedPointer<ReplayLog> block, double progress) {
+            QMetaObject::invokeMethod(this, [this, gen, block, progress] { onBlock(gen, block, progress); },
+                                      Qt::QueuedConnection);
+        }, &err);
+        QMetaObject::invokeMethod(this, [this, gen, ok, err] { onLoadDone(gen, ok, err); },
+                                  Qt::QueuedConnection);
+    });
+    t->setObjectName(QStringLiteral("KeyDash replay loader"));
+    m_loaders.append(t);
+    connect(t, &QThread::finished, this, [this, t] {
+        m_loaders.removeOne(t);
+        t->deleteLater();
+    });
+    t->start(QThread::LowPriority);
+}
+
+void LogReplayEngine::onBlock(quint64 generation, QSharedPointer<ReplayLog> block, double progress) {
+    if (generation != m_generation) return; // superseded by a newer load()/clear()
+    const bool first = m_log.rows() == 0;
+    m_log.append(*block);
+    updatePyramids(false);
+    m_progress = progress;
+    emit loadProgressChanged();
+    emit durationChanged();
+
+    if (first && m_log.rows()) {
+        m_index = 0;
+        m_position = 0;
+        m_last.fill(qQNaN());
+        accumulate(0);
+        emit positionChanged();
+        emit loaded(m_log.rows(), int(m_log.durationMs()));
+        if (m_playWhenLoaded) {
+            m_playWhenLoaded = false;
+            setPlaying(true);
+        }
+    }
+}
+
+void LogReplayEngine::onLoadDone(quint64 generation, bool ok, const QString &error) {
+    if (generation != m_generation) return;
+    setLoading(false);
+    if (!ok) setError(error);
+    m_playWhenLoaded = false;
+
+    const bool wasSorted = m_log.sorted;
+    m_log.finish();
+    if (!wasSorted) {
+        updatePyramids(true);
+        seek(int(m_position)); // rows moved; re-find the playhead
+    }
+    m_progress = 1.0;
+    emit loadProgressChanged();
+    emit durationChanged();
+    emit loadFinished(m_log.rows(), int(m_log.durationMs()));
+}
+
+void LogReplayEngine::seek(int ms) {
+    if (!m_log.rows()) {
+        m_position = 0;
+        m_index = 0;
+        emit positionChanged();
+        return;
+    }
+    m_position = qBound<qint64>(0, ms, m_log.durationMs());
+    // last row with t <= position, then the full state at that row
+    const auto it = std::upper_bound(m_log.t.cbegin(), m_log.t.cend(), m_position);
+    m_index = qMax(0, int(it - m_log.t.cbegin()) - 1);
+    m_last = m_log.stateAt(m_index);
+    rebase();
+    apply();
+    emit positionChanged();
+}
+
+void LogReplayEngine::rebase() {
+    m_clockBase = m_position;
+    m_clock.start();
+}
+
+void LogReplayEngine::onTick() {
+    advanceTo(m_clockBase + qint64(m_clock.elapsed() * m_speed));
+}
+
+void LogReplayEngine::advanceTo(qint64 ms) {
+    if (!m_log.rows()) return;
+    const qint64 end = m_log.durationMs();
+    m_position = qBound<qint64>(0, ms, end);
+
+    const int rows = m_log.rows();
+    while (m_index + 1 < rows && m_log.t[m_index + 1] <= m_position)
+        accumulate(++m_index);
+    apply();
+    emit positionChanged();
+
+    if (m_position >= end && m_loading) {
+        rebase(); // caught up with the loader: hold here until more arrives
+    } else if (m_position >= end) {
+        if (m_loop) {
+            seek(0);
+        } else {
+            setPlaying(false);
+            emit ended();
+        }
+    }
+}
+
+void LogReplayEngine::apply() {
+    if (!m_dash) return;
+    DashModel *d = m_dash;
+    auto pick = [this](ReplayLog::Field f, double current) {
+        return qIsNaN(m_last[f]) ? current : double(m_last[f]);
+    };
+
+    double speed = d->speed();
+    if (!qIsNaN(m_last[ReplayLog::Speed])) speed = m_last[ReplayLog::Speed];
+    else if (!qIsNaN(m_last[ReplayLog::Kph])) speed = m_last[ReplayLog::Kph] / 1.60934;
+
+    // Boost: logged psi, else derived from absolute MAP (kPa)
+    double boost = d->boost();
+    if (!qIsNaN(m_last[ReplayLog::Boost])) boost = m_last[ReplayLog::Boost];
+    else if (!qIsNaN(m_last[ReplayLog::Map])) boost = qMax(0.0, (m_last[ReplayLog::Map] - 101.325) * 0.1450377377);
+
+    double afr = d->afr();
+    if (!qIsNaN(m_last[ReplayLog::Afr])) afr = m_last[ReplayLog::Afr];
+    else if (!qIsNaN(m_last[ReplayLog::Lambda])) afr = m_last[ReplayLog::Lambda] * 14.7;
+
+    const int gear = qIsNaN(m_last[ReplayLog::Gear]) ? d->gear() : qRound(m_last[ReplayLog::Gear]);
+
+    d->applySample(pick(ReplayLog::Rpm, d->rpm()), speed, boost,
+                   pick(ReplayLog::Clt, d->clt()), pick(ReplayLog::Iat, d->iat()),
+                   pick(ReplayLog::Vbat, d->vbat()), afr, gear);
+}
+
+void LogReplayEngine::setLoading(bool on) {
+    if (on == m_loading) return;
+    m_loading = on;
+    emit loadingChanged();
+}
+
+void LogReplayEngine::setError(const QString &e) {
+    if (e == m_error) return;
+    m_error = e;
+    emit errorChanged();
+}
+
+void LogReplayEngine::updatePyramids(bool rebuild) {
+    m_pyramids.resize(m_log.cols.size());
+    for (int c = 0; c < m_pyramids.size(); ++c) {
+        if (rebuild) m_pyramids[c].clear();
+        m_pyramids[c].extend(m_log.cols[c]);
+    }
+    emit seriesChanged();
+}
+
+int LogReplayEngine::columnIndex(const QString &column) const {
+    const int f = ReplayLog::fieldFor(column);
+    if (f >= 0 && m_log.field[f] >= 0) return m_log.field[f];
+    return m_log.names.indexOf(column);
+}
+
+QVariantMap LogReplayEngine::series(const QString &column, int t0, int t1, int pixels) const {
+    const int c = columnIndex(column);
+    if (c < 0 || c >= m_pyramids.size() || pixels <= 0 || !m_log.rows()) return {};
+    pixels = qMin(pixels, 8192);
+    if (t1 <= t0) t1 = t0 + 1;
+
+    const QVector<qint64> &t = m_log.t;
+    const QVector<float> &col = m_log.cols[c];
+    const DecimationPyramid &pyr = m_pyramids[c];
+    const double dt = double(t1 - t0) / pixels;
+
+    QList<qreal> mn, mx, avg;
+    mn.reserve(pixels);
+    mx.reserve(pixels);
+    avg.reserve(pixels);
+    auto a = std::lower_bound(t.cbegin(), t.cend(), qint64(t0));
+    for (int i = 0; i < pixels; ++i) {
+        const double tEnd = t0 + (i + 1) * dt;
+        const auto b = std::partition_point(a, t.cend(), [tEnd](qint64 v) { return v < tEnd; });
+        const DecimationPyramid::Bucket bk = pyr.range(col, int(a - t.cbegin()), int(b - t.cbegin()));
+        mn.append(bk.count ? bk.min : qQNaN());
+        mx.append(bk.count ? bk.max : qQNaN());
+        avg.append(bk.mean());
+        a = b;
+    }
+
+    QVariantMap m;
+    m.insert("min", QVariant::fromValue(mn));
+    m.insert("max", QVariant::fromValue(mx));
+    m.insert("mean", QVariant::fromValue(avg));
+    return m;
+}
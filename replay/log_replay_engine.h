@@ -0,0 +1,135 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QUrl>
+#include <QVariantMap>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <memory>
+#include "decimation_pyramid.h"
+#include "replay_log.h"
+
+class DashModel;
+class QThread;
+
+// Native log replay for ReplayPage (replaces LogReplayController.qml and
+// LogParser.js). Logs are parsed into typed column arrays on a worker
+// thread; playback follows a monotonic clock scaled by `speed` and feeds the
+// target DashModel directly, so no per-frame JS objects are created.
+//
+// Loading is progressive: blocks are appended as the loader produces them,
+// loaded() fires as soon as the first block is playable, duration grows
+// while `loading` is true, and loadFinished() fires at the end. Playback
+// that catches up with the loader holds at the end until more arrives.
+//
+// Positions and durations are in ms, like the QML controller it replaces.
+class LogReplayEngine : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QUrl sourceUrl READ sourceUrl WRITE setSourceUrl NOTIFY sourceUrlChanged)
+    Q_PROPERTY(QObject *target READ target WRITE setTarget NOTIFY targetChanged)
+    Q_PROPERTY(bool playing READ playing WRITE setPlaying NOTIFY playingChanged)
+    Q_PROPERTY(bool loop READ loop WRITE setLoop NOTIFY loopChanged)
+    Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+    Q_PROPERTY(int position READ position WRITE seek NOTIFY positionChanged)
+    Q_PROPERTY(int duration READ duration NOTIFY durationChanged)
+    Q_PROPERTY(int frameIndex READ frameIndex NOTIFY positionChanged)
+    Q_PROPERTY(int frameCount READ frameCount NOTIFY durationChanged)
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
+    Q_PROPERTY(double loadProgress READ loadProgress NOTIFY loadProgressChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY errorChanged)
+
+  public:
+    explicit LogReplayEngine(QObject *parent=nullptr);
+    ~LogReplayEngine();
+
+    QUrl    sourceUrl() const { return m_source; }
+    QObject *target() const;
+    bool    playing() const { return m_playing; }
+    bool    loop() const { return m_loop; }
+    double  speed() const { return m_speed; }
+    int     position() const { return int(m_position); }
+    int     duration() const { return int(m_log.durationMs()); }
+    int     frameIndex() const { return m_index; }
+    int     frameCount() const { return m_log.rows(); }
+    bool    loading() const { return m_loading; }
+    double  loadProgress() const { return m_progress; }
+    QString errorString() const { return m_error; }
+
+    void setSourceUrl(const QUrl &u);
+    void setTarget(QObject *t);
+    void setPlaying(bool on);
+    void setLoop(bool on);
+    void setSpeed(double s);
+
+    Q_INVOKABLE void load();   // parse sourceUrl in the background
+    Q_INVOKABLE void cancelLoad(); // keep what is loaded so far
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE void play();   // deferred until loaded if still loading
+    Q_INVOKABLE void pause();
+    Q_INVOKABLE void stop();   // pause + seek(0)
+    Q_INVOKABLE void seek(int ms);
+
+           // Overview traces: exactly `pixels` buckets over [t0, t1] ms, as
+           // {min: [], max: [], mean: []} (NaN where a pixel has no sample).
+           // `column` is a column name or a field alias (rpm, boost, afr, ...).
+    Q_INVOKABLE QVariantMap series(const QString &column, int t0, int t1, int pixels) const;
+    Q_INVOKABLE bool hasColumn(const QString &column) const { return columnIndex(column) >= 0; }
+    Q_INVOKABLE QStringList columns() const { return m_log.names; }
+
+  signals:
+    void sourceUrlChanged();
+    void targetChanged();
+    void playingChanged();
+    void loopChanged();
+    void speedChanged();
+    void positionChanged();
+    void durationChanged();
+    void loadingChanged();
+    void loadProgressChanged();
+    void errorChanged();
+    void seriesChanged();                              // more data summarized
+    void loaded(int frameCount, int durationMs);       // first block playable
+    void loadFinished(int frameCount, int durationMs); // whole file (or cancelled)
+    void ended();
+
+  private:
+    void onBlock(quint64 generation, QSharedPointer<ReplayLog> block, double progress);
+    void onLoadDone(quint64 generation, bool ok, const QString &error);
+    void onTick();
+    void rebase();                  // restart the clock at m_position
+    void advanceTo(qint64 ms);
+    void accumulate(int row) { m_log.fold(m_last, row); }
+    void apply();                   // push m_last into the DashModel
+    void setLoading(bool on);
+    void updatePyramids(bool rebuild);
+    int  columnIndex(const QString &column) const;
+    void setError(const QString &e);
+
+    QUrl m_source;
+    QPointer<DashModel> m_dash;
+    ReplayLog m_log;
+    QVector<DecimationPyramid> m_pyramids; // one per m_log column
+
+    QTimer m_tick;
+    QElapsedTimer m_clock;
+    qint64 m_clockBase{0};          // m_position when m_clock was started
+    qint64 m_position{0};
+    int m_index{0};
+    ReplayLog::State m_last;        // values applied to the DashModel
+
+    bool m_playing{false};
+    bool m_loop{false};
+    bool m_loading{false};
+    bool m_playWhenLoaded{false};
+    double m_progress{0.0};
+    double m_speed{1.0};
+    QString m_error;
+
+    quint64 m_generation{0};        // ignores results of superseded loads
+    std::shared_ptr<std::atomic<bool>> m_cancel;
+    QVector<QThread *> m_loaders;
+};
@@ -0,0 +1,112 @@
+#include "replay_log.h"
+#include <QHash>
+#include <algorithm>
+#include <numeric>
+
+int ReplayLog::fieldFor(const QString &name) {
+    // Short CSV headers (old LogParser.js / DashModel logger) and signal
+    // registry names (raw .kdlog).
+    static const QHash<QString, int> aliases = {
+        {"rpm", Rpm}, {"engine.rpm", Rpm},
+        {"speed", Speed}, {"mph", Speed},
+        {"kph", Kph}, {"kmh", Kph}, {"vehicle.speedkph", Kph},
+        {"boost", Boost}, {"engine.boost_psi", Boost},
+        {"map", Map}, {"engine.map_kpa", Map},
+        {"clt", Clt}, {"coolant", Clt}, {"temps.clt_c", Clt},
+        {"iat", Iat}, {"intake", Iat}, {"mat", Iat}, {"temps.iat_c", Iat},
+        {"vbat", Vbat}, {"batt", Vbat}, {"volt", Vbat}, {"electrical.vbat_v", Vbat},
+        {"afr", Afr}, {"lambda.afr", Afr},
+        {"lambda", Lambda}, {"lambda.lambda", Lambda},
+        {"gear", Gear}, {"drivetrain.gear", Gear},
+    };
+    return aliases.value(name.trimmed().toLower(), -1);
+}
+
+int ReplayLog::addColumn(const QString &name) {
+    const int existing = names.indexOf(name);
+    if (existing >= 0) return existing;
+    const int c = names.size();
+    names.append(name);
+    cols.append(QVector<float>(t.size(), qQNaN()));
+    const int f = fieldFor(name);
+    if (f >= 0 && field[f] < 0) field[f] = c;
+    return c;
+}
+
+void ReplayLog::sortBlock() {
+    if (std::is_sorted(t.cbegin(), t.cend())) return;
+    QVector<int> order(t.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return t[a] < t[b]; });
+    QVector<qint64> st(t.size());
+    for (int i = 0; i < order.size(); ++i) st[i] = t[order[i]];
+    t = st;
+    for (QVector<float> &col : cols) {
+        QVector<float> sc(col.size());
+        for (int i = 0; i < order.size(); ++i) sc[i] = col[order[i]];
+        col = sc;
+    }
+}
+
+void ReplayLog::append(const ReplayLog &b) {
+    if (b.t.isEmpty()) return;
+    if (t.isEmpty()) origin = b.t.first();
+
+    const int before = t.size();
+    const int n = b.t.size();
+    if (before && b.t.first() - origin < t.last()) sorted = false;
+
+    QVector<int> dst(b.names.size());
+    for (int i = 0; i < b.names.size(); ++i)
+        dst[i] = addColumn(b.names.at(i));
+
+    t.reserve(before + n);
+    for (qint64 v : b.t) t.append(v - origin);
+
+    QVector<bool> filled(cols.size(), false);
+    for (int i = 0; i < b.names.size(); ++i) {
+        if (filled[dst[i]]) continue; // duplicate header
+        cols[dst[i]] += b.cols.at(i);
+        filled[dst[i]] = true;
+    }
+    for (int c = 0; c < cols.size(); ++c)
+        if (!filled[c]) cols[c].resize(before + n, qQNaN());
+
+    if (sorted) updateKeyframes(); // rebuilt by finish() otherwise
+}
+
+void ReplayLog::updateKeyframes() {
+    for (int r = keyedRows; r < rows(); ++r) {
+        fold(keyState, r);
+        if (r % kKeyframeRows == 0) keyframes.append(keyState);
+    }
+    keyedRows = rows();
+}
+
+ReplayLog::State ReplayLog::stateAt(int row) const {
+    State s;
+    s.fill(qQNaN());
+    if (row < 0 || row >= rows()) return s;
+    const int k = qMin(row / kKeyframeRows, int(keyframes.size()) - 1);
+    if (k < 0) return s;
+    s = keyframes[k];
+    for (int r = k * kKeyframeRows + 1; r <= row; ++r)
+        fold(s, r);
+    return s;
+}
+
+void ReplayLog::finish() {
+    if (!sorted) {
+        sortBlock();
+        sorted = true;
+        keyframes.clear();
+        keyState.fill(qQNaN());
+        keyedRows = 0;
+        updateKeyframes();
+    }
+    if (!t.isEmpty() && t.first() != 0) {
+        const qint64 t0 = t.first();
+        origin += t0;
+        for (qint64 &v : t) v -= t0;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <QStringList>
+#include <QVector>
+#include <QtNumeric>
+#include <array>
+
+// A session log loaded for replay: one timestamp array and one float array
+// per logged column (NaN where a row did not log that column).
+//
+// Logs are built incrementally: the loader produces blocks (ReplayLogs with
+// absolute timestamps) and the engine append()s them as they arrive, so
+// playback can start on the first block.
+//
+// Seeking: `t` is the sorted timestamp index (binary search), and every
+// kKeyframeRows rows a keyframe snapshots the last known value of every
+// Field. stateAt() restores the full dashboard state at any row from the
+// nearest keyframe plus at most kKeyframeRows - 1 rows, so signals that
+// were not logged in the row at the seek point still get their values.
+struct ReplayLog {
+    // Columns the replay engine knows how to feed into DashModel.
+    enum Field : quint8 {
+        Rpm, Speed, Kph, Boost, Map, Clt, Iat, Vbat, Afr, Lambda, Gear, FieldCount
+    };
+
+    QVector<qint64>         t;      // ms since origin (ascending once finished)
+    QStringList             names;  // column names as found in the file
+    QVector<QVector<float>> cols;   // one per name, rows() entries each
+    std::array<int, FieldCount> field; // column per Field, -1 if absent
+    qint64                  origin = 0;    // absolute time of t == 0
+    bool                    sorted = true; // false if a block went back in time
+
+    static constexpr int kKeyframeRows = 1024;
+    using State = std::array<float, FieldCount>; // NaN = never logged so far
+
+    QVector<State>          keyframes;      // state after row k * kKeyframeRows
+
+    ReplayLog() {
+        field.fill(-1);
+        keyState.fill(qQNaN());
+    }
+
+    int    rows() const { return t.size(); }
+    qint64 durationMs() const { return t.isEmpty() ? 0 : t.last(); }
+    float  value(Field f, int row) const {
+        const int c = field[f];
+        return c < 0 ? qQNaN() : cols[c][row];
+    }
+
+    void  fold(State &s, int row) const {   // apply one row on top of s
+        for (int f = 0; f < FieldCount; ++f) {
+            const float v = value(Field(f), row);
+            if (!qIsNaN(v)) s[f] = v;
+        }
+    }
+    State stateAt(int row) const;
+
+    int  addColumn(const QString &name);     // existing index if already present
+    void sortBlock();                        // sort rows by t (loader side)
+    void append(const ReplayLog &block);     // merge columns by name
+    void finish();                           // final sort if needed, rebase to 0
+
+    static int fieldFor(const QString &name); // -1 if not a known column
+
+  private:
+    void updateKeyframes();                  // extend to cover all rows
+
+    State keyState;                          // state after row keyedRows - 1
+    int   keyedRows = 0;
+};
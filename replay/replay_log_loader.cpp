@@ -0,0 +1,282 @@
+#include "replay_log_loader.h"
+#include "logging/session_log_reader.h"
+#include <QByteArrayView>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+enum class TimeUnit { None, Ms, Seconds };
+
+TimeUnit timeColumn(const QString &name) {
+    const QString lower = name.trimmed().toLower();
+    if (lower == QLatin1String("timestamp_ms") || lower == QLatin1String("time_ms") ||
+        lower == QLatin1String("ts_ms"))
+        return TimeUnit::Ms;
+    if (lower == QLatin1String("t"))
+        return TimeUnit::Seconds;
+    return TimeUnit::None;
+}
+
+qint64 toMs(double v, TimeUnit u) {
+    return u == TimeUnit::Seconds ? qint64(v * 1000.0) : qint64(v);
+}
+
+float toFloat(QByteArrayView field) {
+    bool ok = false;
+    const double v = field.trimmed().toDouble(&ok);
+    return ok ? float(v) : qQNaN();
+}
+
+// Next non-blank line in [*p, end), without the line terminator.
+bool nextLine(const char *&p, const char *end, QByteArrayView *line) {
+    while (p < end) {
+        const char *nl = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p)));
+        const char *e = nl ? nl : end;
+        *line = QByteArrayView(p, e - p);
+        p = nl ? nl + 1 : end;
+        if (line->endsWith('\r')) line->chop(1);
+        if (!line->trimmed().isEmpty()) return true;
+    }
+    return false;
+}
+
+// Array of flat JSON objects -> block with absolute timestamps.
+QSharedPointer<ReplayLog> jsonBlock(const QJsonArray &arr, int firstRow) {
+    auto block = QSharedPointer<ReplayLog>::create();
+    QHash<QString, int> colIndex;
+    block->t.reserve(arr.size());
+    for (int row = 0; row < arr.size(); ++row) {
+        const QJsonObject o = arr.at(row).toObject();
+        qint64 t = firstRow + row; // rows without a time key replay at 1 ms steps
+        for (auto it = o.constBegin(); it != o.constEnd(); ++it) {
+            const TimeUnit u = timeColumn(it.key());
+            if (u != TimeUnit::None) {
+                t = toMs(it.value().toDouble(), u);
+                continue;
+            }
+            if (!it.value().isDouble() && !it.value().isString()) continue;
+            int c = colIndex.value(it.key(), -1);
+            if (c < 0) {
+                c = block->names.size();
+                colIndex.insert(it.key(), c);
+                block->names.append(it.key());
+                block->cols.append(QVector<float>(row, qQNaN()));
+            }
+            QVector<float> &col = block->cols[c];
+            col.resize(row, qQNaN());
+            col.append(it.value().isDouble() ? float(it.value().toDouble())
+                                             : toFloat(it.value().toString().toUtf8()));
+        }
+        block->t.append(t);
+    }
+    for (QVector<float> &col : block->cols)
+        col.resize(block->t.size(), qQNaN());
+    return block;
+}
+
+} // namespace
+
+bool ReplayLogLoader::run(const BlockFn &onBlock, QString *error) {
+    if (m_path.endsWith(QLatin1String(".kdlog"), Qt::CaseInsensitive))
+        return runKdLog(onBlock, error);
+
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (error) *error = f.errorString();
+        return false;
+    }
+    // Map the file (pages come in as the parser walks it); compressed qrc
+    // resources cannot be mapped and are read in one go instead.
+    QByteArray owned;
+    const char *data = reinterpret_cast<const char *>(f.size() > 0 ? f.map(0, f.size()) : nullptr);
+    qsizetype size = f.size();
+    if (!data) {
+        owned = f.readAll();
+        data = owned.constData();
+        size = owned.size();
+    }
+
+    const char *p = data;
+    while (p < data + size && std::isspace(uchar(*p))) ++p;
+    if (p == data + size) {
+        if (error) *error = QStringLiteral("empty log");
+        return false;
+    }
+    return (*p == '[' || *p == '{') ? runJson(data, size, onBlock, error)
+                                    : runCsv(data, size, onBlock, error);
+}
+
+bool ReplayLogLoader::runCsv(const char *data, qsizetype size, const BlockFn &onBlock, QString *error) {
+    const char *p = data;
+    const char *end = data + size;
+
+    QByteArrayView line;
+    if (!nextLine(p, end, &line)) {
+        if (error) *error = QStringLiteral("empty log");
+        return false;
+    }
+
+    int tCol = -1;
+    TimeUnit tUnit = TimeUnit::None;
+    QStringList names;
+    QVector<int> colOf; // csv column -> block column, -1 = time
+    qsizetype pos = 0;
+    for (int c = 0; pos <= line.size(); ++c) {
+        qsizetype comma = line.indexOf(',', pos);
+        if (comma < 0) comma = line.size();
+        const QString name = QString::fromUtf8(line.sliced(pos, comma - pos)).trimmed();
+        pos = comma + 1;
+        const TimeUnit u = timeColumn(name);
+        if (u != TimeUnit::None && tCol < 0) {
+            tCol = c;
+            tUnit = u;
+            colOf.append(-1);
+            continue;
+        }
+        colOf.append(names.size());
+        names.append(name);
+    }
+
+    int row = 0;
+    while (p < end) {
+        if (cancelled()) return true;
+
+        auto block = QSharedPointer<ReplayLog>::create();
+        block->names = names;
+        block->cols.resize(names.size());
+        block->t.reserve(kBlockRows);
+        for (QVector<float> &c : block->cols) c.reserve(kBlockRows);
+
+        while (block->t.size() < kBlockRows && nextLine(p, end, &line)) {
+            qint64 t = row++;
+            pos = 0;
+            int c = 0;
+            for (; c < colOf.size() && pos <= line.size(); ++c) {
+                qsizetype comma = line.indexOf(',', pos);
+                if (comma < 0) comma = line.size();
+                const QByteArrayView field = line.sliced(pos, comma - pos);
+                pos = comma + 1;
+                if (c == tCol)
+                    t = toMs(field.trimmed().toDouble(), tUnit);
+                else
+                    block->cols[colOf[c]].append(toFloat(field));
+            }
+            for (; c < colOf.size(); ++c) // short row
+                if (colOf[c] >= 0) block->cols[colOf[c]].append(qQNaN());
+            block->t.append(t);
+        }
+        if (block->t.isEmpty()) break;
+        block->sortBlock();
+        onBlock(block, double(p - data) / double(size));
+    }
+    return true;
+}
+
+bool ReplayLogLoader::runJson(const char *data, qsizetype size, const BlockFn &onBlock, QString *error) {
+    const char *p = data;
+    const char *end = data + size;
+    while (p < end && std::isspace(uchar(*p))) ++p;
+    if (p == end || *p != '[') {
+        if (error) *error = QStringLiteral("expected a JSON array");
+        return false;
+    }
+    ++p;
+
+    // Split the top-level array into runs of kBlockRows objects and parse
+    // each run as its own array.
+    int row = 0;
+    while (p < end) {
+        if (cancelled()) return true;
+
+        const char *runStart = nullptr;
+        const char *runEnd = nullptr;
+        int objects = 0;
+        int depth = 0;
+        bool inString = false;
+        for (; p < end && objects < kBlockRows; ++p) {
+            const char ch = *p;
+            if (inString) {
+                if (ch == '\\') ++p;
+                else if (ch == '"') inString = false;
+                continue;
+            }
+            if (ch == '"') {
+                inString = true;
+            } else if (ch == '{' || ch == '[') {
+                if (depth++ == 0 && !runStart) runStart = p;
+            } else if (ch == '}' || ch == ']') {
+                if (depth == 0) { p = end; break; } // closing bracket of the log
+                if (--depth == 0) {
+                    runEnd = p + 1;
+                    ++objects;
+                }
+            }
+        }
+        if (!objects) break;
+
+        QByteArray run;
+        run.reserve(runEnd - runStart + 2);
+        run.append('[').append(runStart, runEnd - runStart).append(']');
+        QJsonParseError pe;
+        const QJsonDocument doc = QJsonDocument::fromJson(run, &pe);
+        if (!doc.isArray()) {
+            if (error) *error = pe.errorString();
+            return false;
+        }
+        auto block = jsonBlock(doc.array(), row);
+        row += objects;
+        block->sortBlock();
+        onBlock(block, double(qMin(p, end) - data) / double(size));
+    }
+    return true;
+}
+
+bool ReplayLogLoader::runKdLog(const BlockFn &onBlock, QString *error) {
+    SessionLogReader reader;
+    if (!reader.open(m_path, error))
+        return false;
+
+    // Channels carry their own timestamps; replay wants rows. Each group of
+    // chunks is merged into one timeline and every sample placed on its row.
+    const QStringList channels = reader.channels();
+    constexpr int kChunksPerBlock = 4;
+    const int chunks = reader.chunkCount();
+    for (int first = 0; first < chunks; first += kChunksPerBlock) {
+        if (cancelled()) return true;
+        const int last = qMin(chunks, first + kChunksPerBlock);
+
+        QVector<QVector<qint64>> ts(channels.size());
+        QVector<QVector<float>> vals(channels.size());
+        QVector<qint64> all;
+        for (int ch = 0; ch < channels.size(); ++ch) {
+            for (int k = first; k < last; ++k)
+                reader.readColumn(k, ch, &ts[ch], &vals[ch]);
+            all += ts[ch];
+        }
+        std::sort(all.begin(), all.end());
+        all.erase(std::unique(all.begin(), all.end()), all.end());
+        if (all.isEmpty()) continue;
+
+        auto block = QSharedPointer<ReplayLog>::create();
+        block->t = all;
+        for (int ch = 0; ch < channels.size(); ++ch) {
+            if (ts[ch].isEmpty()) continue;
+            QVector<float> col(all.size(), qQNaN());
+            for (int k = 0; k < ts[ch].size(); ++k) {
+                const auto it = std::lower_bound(all.cbegin(), all.cend(), ts[ch][k]);
+                col[int(it - all.cbegin())] = vals[ch][k];
+            }
+            block->names.append(channels.at(ch));
+            block->cols.append(col);
+        }
+        onBlock(block, double(last) / double(chunks));
+    }
+    return true;
+}
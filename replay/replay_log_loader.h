@@ -0,0 +1,39 @@
+#pragma once
+#include <QSharedPointer>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include "replay_log.h"
+
+// Streams a session log into ReplayLog blocks of ~kBlockRows rows.
+//
+// Runs on a worker thread: the file is memory-mapped where possible (read
+// once otherwise), rows are parsed straight from the UTF-8 bytes and every
+// finished block is handed to onBlock() together with the fraction of the
+// file consumed so far. `cancel` is polled between blocks.
+//
+//   CSV    header row; time column timestamp_ms / time_ms / ts_ms, or t [s]
+//   JSON   array of flat objects, split into blocks at top-level commas
+//   .kdlog a few chunks per block (see session_log_format.h)
+class ReplayLogLoader {
+  public:
+    static constexpr int kBlockRows = 65536;
+
+    using BlockFn = std::function<void(QSharedPointer<ReplayLog> block, double progress)>;
+
+    ReplayLogLoader(const QString &path, const std::atomic<bool> *cancel = nullptr)
+        : m_path(path), m_cancel(cancel) {}
+
+           // Returns false (and sets *error) on failure; a cancelled load
+           // returns true.
+    bool run(const BlockFn &onBlock, QString *error = nullptr);
+
+  private:
+    bool cancelled() const { return m_cancel && m_cancel->load(std::memory_order_relaxed); }
+    bool runCsv(const char *data, qsizetype size, const BlockFn &onBlock, QString *error);
+    bool runJson(const char *data, qsizetype size, const BlockFn &onBlock, QString *error);
+    bool runKdLog(const BlockFn &onBlock, QString *error);
+
+    QString m_path;
+    const std::atomic<bool> *m_cancel;
+};
@@ -0,0 +1,95 @@
+#include "can_filter.h"
+#include <QHash>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+constexpr quint32 kStdMask = 0x7FF;
+constexpr quint32 kExtMask = 0x1FFFFFFF;
+
+// One pass of pairwise merging among filters with the same mask. Returns
+// true if anything merged.
+bool mergePass(QVector<CanFilter> &fs) {
+    std::sort(fs.begin(), fs.end(), [](const CanFilter &a, const CanFilter &b) {
+        return a.mask != b.mask ? a.mask < b.mask : a.id < b.id;
+    });
+    QHash<quint64, int> at; // (mask, id) -> index
+    for (int i = 0; i < fs.size(); ++i)
+        at.insert(quint64(fs[i].mask) << 32 | fs[i].id, i);
+
+    QVector<bool> used(fs.size(), false);
+    QVector<CanFilter> out;
+    out.reserve(fs.size());
+    bool merged = false;
+    for (int i = 0; i < fs.size(); ++i) {
+        if (used[i]) continue;
+        const CanFilter &f = fs[i];
+        used[i] = true;
+        CanFilter result = f;
+        for (quint32 bit = 1; bit && bit <= f.mask; bit <<= 1) {
+            if (!(f.mask & bit) || (f.id & bit)) continue; // partner has the bit set
+            const auto it = at.constFind(quint64(f.mask) << 32 | (f.id | bit));
+            if (it == at.cend() || used[*it]) continue;
+            used[*it] = true;
+            result.mask = f.mask & ~bit;
+            merged = true;
+            break;
+        }
+        out.append(result);
+    }
+    fs = out;
+    return merged;
+}
+
+// Bits two filters would lose if widened into one.
+int widenCost(const CanFilter &a, const CanFilter &b) {
+    const quint32 mask = a.mask & b.mask & ~(a.id ^ b.id);
+    return qPopulationCount(a.mask) + qPopulationCount(b.mask) - 2 * qPopulationCount(mask);
+}
+
+QVector<CanFilter> filtersFor(const QVector<quint32> &ids, bool extended, int maxFilters) {
+    QVector<CanFilter> fs;
+    fs.reserve(ids.size());
+    const quint32 full = extended ? kExtMask : kStdMask;
+    for (quint32 id : ids)
+        fs.append({id & full, full, extended});
+    while (mergePass(fs)) {}
+
+    while (fs.size() > qMax(1, maxFilters)) {
+        int bi = 0, bj = 1, best = INT_MAX;
+        for (int i = 0; i < fs.size(); ++i)
+            for (int j = i + 1; j < fs.size(); ++j) {
+                const int c = widenCost(fs[i], fs[j]);
+                if (c < best) { best = c; bi = i; bj = j; }
+            }
+        CanFilter w;
+        w.extended = extended;
+        w.mask = fs[bi].mask & fs[bj].mask & ~(fs[bi].id ^ fs[bj].id);
+        w.id = fs[bi].id & w.mask;
+        fs[bi] = w;
+        fs.removeAt(bj);
+    }
+    return fs;
+}
+
+} // namespace
+
+QVector<CanFilter> computeCanFilters(const QVector<CanId> &ids, int maxFilters) {
+    QVector<quint32> std11, ext29;
+    for (const CanId &c : ids)
+        (c.extended ? ext29 : std11).append(c.id);
+    for (QVector<quint32> *v : {&std11, &ext29}) {
+        std::sort(v->begin(), v->end());
+        v->erase(std::unique(v->begin(), v->end()), v->end());
+    }
+
+    // Split the budget in proportion to each format's share of the ids
+    const int total = std11.size() + ext29.size();
+    if (!total) return {};
+    const int stdBudget = std11.isEmpty() ? 0 : qMax(1, maxFilters * std11.size() / total);
+    QVector<CanFilter> out = filtersFor(std11, false, stdBudget);
+    out += filtersFor(ext29, true, qMax(1, maxFilters - stdBudget));
+    return out;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <QVector>
+#include "core/itransport.h"
+
+// One acceptance filter: a frame matches when (frameId & mask) == id and
+// its id format (11/29-bit) equals `extended`.
+struct CanFilter {
+    quint32 id = 0;
+    quint32 mask = 0;
+    bool    extended = false;
+};
+
+// Smallest practical set of ID/mask filters for a decode set, for kernel-
+// side filtering (CAN_RAW_FILTER). Ids that differ in one masked bit are
+// merged repeatedly, which never accepts an id outside the set. If more
+// than `maxFilters` remain, the closest pairs are widened until the set
+// fits; those filters let some extra ids through, which protocols ignore.
+// An empty decode set yields no filters (the caller accepts everything).
+QVector<CanFilter> computeCanFilters(const QVector<CanId> &ids, int maxFilters = 64);
@@ -2,18 +2,39 @@
 #include <QCanBus>
 #include <QCanBusDevice>
 #include <QCanBusFrame>
+#include <QFile>
+
+CanTransport::CanTransport(const QString &iface, const QString &plugin, QObject *parent)
+    : ITransport(parent), m_iface(iface), m_plugin(plugin), m_statsTimer(this) {
+    m_statsTimer.setInterval(kStatsPeriodMs);
+    connect(&m_statsTimer, &QTimer::timeout, this, &CanTransport::publishFilterStats);
+}
 
 bool CanTransport::open() {
     if (m_dev && m_dev->state() == QCanBusDevice::ConnectedState) return true;
     QString errStr;
     m_dev = QCanBus::instance()->createDevice(m_plugin, m_iface, &errStr);
     if (!m_dev) return false;
+    m_dev->setParent(this); // created on (and follows) the transport's thread
+
+    // Only errors the dash can act on; bus errors on a noisy bus would
+    // otherwise arrive as a stream of error frames.
+    const QCanBusFrame::FrameErrors errors = QCanBusFrame::BusOffError | QCanBusFrame::ControllerError |
+                                             QCanBusFrame::ControllerRestartError |
+                                             QCanBusFrame::TransmissionTimeoutError;
+    m_dev->setConfigurationParameter(QCanBusDevice::ErrorFilterKey, QVariant::fromValue(errors));
+    applyFilters();
+
     if (!m_dev->connectDevice()) return false;
     connect(m_dev, &QCanBusDevice::framesReceived, this, &CanTransport::onFramesReceived);
+    m_lastRx = readRxPackets();
+    m_lastDelivered = m_delivered;
+    m_statsTimer.start();
     return true;
 }
 
 void CanTransport::close() {
+    m_statsTimer.stop();
     if (m_dev) m_dev->disconnectDevice();
 }
 
@@ -27,10 +48,66 @@ bool CanTransport::write(quint32 id, const QByteArray &payload) {
     return m_dev->writeFrame(f);
 }
 
+void CanTransport::setCanIds(const QVector<CanId> &ids) {
+    m_filters = computeCanFilters(ids, kMaxFilters);
+    applyFilters();
+}
+
+void CanTransport::applyFilters() {
+    if (!m_dev) return;
+    // A default Filter (id 0, mask 0, any format) accepts every frame; an
+    // empty list would accept none.
+    QList<QCanBusDevice::Filter> list;
+    for (const CanFilter &f : std::as_const(m_filters)) {
+        QCanBusDevice::Filter q;
+        q.frameId     = f.id;
+        q.frameIdMask = f.mask;
+        q.type        = QCanBusFrame::DataFrame;
+        q.format      = f.extended ? QCanBusDevice::Filter::MatchExtendedFormat
+                                   : QCanBusDevice::Filter::MatchBaseFormat;
+        list.append(q);
+    }
+    if (list.isEmpty())
+        list.append(QCanBusDevice::Filter());
+    // Applied right away on a connected socketcan device, on connect otherwise
+    m_dev->setConfigurationParameter(QCanBusDevice::RawFilterKey, QVariant::fromValue(list));
+    m_filterCount->set(m_filters.size());
+}
+
+qint64 CanTransport::readRxPackets() const {
+    QFile f(QStringLiteral("/sys/class/net/%1/statistics/rx_packets").arg(m_iface));
+    if (!f.open(QIODevice::ReadOnly)) return -1;
+    bool ok = false;
+    const qint64 v = f.readAll().trimmed().toLongLong(&ok);
+    return ok ? v : -1;
+}
+
+void CanTransport::publishFilterStats() {
+    const qint64 rx = readRxPackets();
+    if (rx < 0 || m_lastRx < 0 || rx < m_lastRx) { // unavailable or counter reset
+        m_lastRx = rx;
+        m_lastDelivered = m_delivered;
+        return;
+    }
+    const quint64 bus = quint64(rx - m_lastRx);
+    const quint64 delivered = m_delivered - m_lastDelivered;
+    m_busFrames->add(bus);
+    m_kernelFiltered->add(bus > delivered ? bus - delivered : 0);
+    m_lastRx = rx;
+    m_lastDelivered = m_delivered;
+}
+
 void CanTransport::onFramesReceived() {
     if (!m_dev) return;
     while (m_dev->framesAvailable() > 0) {
         const QCanBusFrame f = m_dev->readFrame();
-        emit canIn(f.frameId(), f.payload());
+        if (f.frameType() == QCanBusFrame::ErrorFrame) { // generated locally, not in rx_packets
+            m_errors->add();
+            continue;
+        }
+        ++m_delivered;
+        m_framesIn->add();
+        m_bytesIn->add(quint64(f.payload().size()));
+        emit canIn(f.frameId(), f.payload(), f.hasExtendedFrameFormat());
     }
 }
@@ -1,28 +1,58 @@
 #pragma once
 #include "core/itransport.h"
+#include "core/pipeline_metrics.h"
+#include "transports/can_filter.h"
 #include <QObject>
 #include <QPointer>
+#include <QTimer>
 
 class QCanBusDevice;
 
+// CAN through QtSerialBus. With setCanIds() the decode set is installed as
+// raw ID/mask filters on the device (CAN_RAW_FILTER for socketcan), so
+// frames nobody decodes are dropped in the kernel instead of waking this
+// thread. Error frames are limited to bus-off / controller problems.
+//
+// "can.busFrames" counts what the interface received (sysfs rx_packets,
+// Linux only) and "can.kernelFiltered" the part of it never delivered.
 class CanTransport : public ITransport {
     Q_OBJECT
   public:
+    static constexpr int kMaxFilters   = 64;
+    static constexpr int kStatsPeriodMs = 1000;
+
     explicit CanTransport(const QString &iface = "can0", const QString &plugin = "socketcan",
-                          QObject *parent=nullptr)
-        : ITransport(parent), m_iface(iface), m_plugin(plugin) {}
+                          QObject *parent=nullptr);
 
     bool open() override;
     void close() override;
     bool isOpen() const override;
+    Kind kind() const override { return Kind::Can; }
+    void setCanIds(const QVector<CanId> &ids) override;
 
            // Optional: write CAN frame
+    using ITransport::write;
     bool write(quint32 id, const QByteArray &payload);
 
   private:
+    void applyFilters();
+    qint64 readRxPackets() const; // -1 if unavailable
+
     QString m_iface, m_plugin;
     QPointer<QCanBusDevice> m_dev;
+    QVector<CanFilter> m_filters;   // empty = accept everything
+    QTimer m_statsTimer;
+    qint64 m_lastRx{-1};
+    quint64 m_lastDelivered{0};
+    quint64 m_delivered{0};
+    PipelineMetrics::Counter *m_framesIn = PipelineMetrics::instance().counter("can.framesIn");
+    PipelineMetrics::Counter *m_bytesIn  = PipelineMetrics::instance().counter("can.bytesIn");
+    PipelineMetrics::Counter *m_errors   = PipelineMetrics::instance().counter("can.errorFrames");
+    PipelineMetrics::Counter *m_busFrames = PipelineMetrics::instance().counter("can.busFrames");
+    PipelineMetrics::Counter *m_kernelFiltered = PipelineMetrics::instance().counter("can.kernelFiltered");
+    PipelineMetrics::Gauge   *m_filterCount = PipelineMetrics::instance().gauge("can.filters");
 
   private slots:
     void onFramesReceived();
+    void publishFilterStats();
 };
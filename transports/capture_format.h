@@ -0,0 +1,79 @@
+#pragma once
+#include <QByteArray>
+#include <QtEndian>
+#include <QtGlobal>
+#include <cstring>
+
+// KeyDash raw transport capture (.kdcap), all integers little-endian.
+//
+//   Header   magic "KDCAP01\0", u16 version, u16 flags, i64 createdMs
+//   Record   i64 tUs (since capture start), u32 canId, u16 len, u8 kind,
+//            u8 flags, payload[len]
+//
+// Records are appended in arrival order, so a truncated file is readable up
+// to its last complete record. ReplayTransport plays these back (and also
+// accepts candump logs for CAN).
+namespace KdCap {
+
+constexpr char    kMagic[8]     = {'K', 'D', 'C', 'A', 'P', '0', '1', '\0'};
+constexpr quint16 kVersion      = 1;
+constexpr int     kHeaderBytes  = 20;
+constexpr int     kRecordBytes  = 16; // fixed part of a record
+
+enum Kind : quint8 {
+    RxBytes = 0, // ITransport::bytesIn
+    TxBytes = 1, // bytes written to the device (informational)
+    RxCan   = 2, // ITransport::canIn
+    TxCan   = 3,
+};
+
+enum RecordFlag : quint8 {
+    CanExtended = 0x01, // 29-bit identifier
+};
+
+struct Record {
+    qint64  tUs = 0;
+    quint32 canId = 0;
+    quint16 len = 0;
+    quint8  kind = RxBytes;
+    quint8  flags = 0;
+};
+
+inline void putHeader(QByteArray &out, qint64 createdMs) {
+    out.append(kMagic, sizeof kMagic);
+    const quint16 v = qToLittleEndian(kVersion), f = 0;
+    const qint64  c = qToLittleEndian(createdMs);
+    out.append(reinterpret_cast<const char *>(&v), 2);
+    out.append(reinterpret_cast<const char *>(&f), 2);
+    out.append(reinterpret_cast<const char *>(&c), 8);
+}
+
+inline void putRecord(QByteArray &out, const Record &r, const char *payload) {
+    char h[kRecordBytes];
+    qToLittleEndian(r.tUs, h);
+    qToLittleEndian(r.canId, h + 8);
+    qToLittleEndian(r.len, h + 12);
+    h[14] = char(r.kind);
+    h[15] = char(r.flags);
+    out.append(h, kRecordBytes);
+    out.append(payload, r.len);
+}
+
+inline bool hasMagic(const QByteArray &data) {
+    return data.size() >= kHeaderBytes && std::memcmp(data.constData(), kMagic, sizeof kMagic) == 0;
+}
+
+// Parses the record at `p`; returns the position after it, or nullptr if
+// fewer than a whole record remains.
+inline const char *getRecord(const char *p, const char *end, Record *r) {
+    if (end - p < kRecordBytes) return nullptr;
+    r->tUs   = qFromLittleEndian<qint64>(p);
+    r->canId = qFromLittleEndian<quint32>(p + 8);
+    r->len   = qFromLittleEndian<quint16>(p + 12);
+    r->kind  = quint8(p[14]);
+    r->flags = quint8(p[15]);
+    if (end - p - kRecordBytes < r->len) return nullptr;
+    return p + kRecordBytes + r->len;
+}
+
+} // namespace KdCap
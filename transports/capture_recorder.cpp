@@ -0,0 +1,232 @@
+#include "capture_recorder.h"
+#include "capture_format.h"
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <QThread>
+#include <cstdio>
+
+CaptureRecorder::CaptureRecorder(QObject *parent) : QObject(parent) {}
+
+CaptureRecorder::~CaptureRecorder() {
+    stop();
+}
+
+bool CaptureRecorder::start(const QString &path, QString *error) {
+    stop();
+
+    m_format = path.endsWith(QLatin1String(".log"), Qt::CaseInsensitive) ? Format::Candump : Format::KdCap;
+    m_file.setFileName(path);
+    // Unbuffered: the writer thread already hands over large blocks
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        m_error = m_file.errorString();
+        if (error) *error = m_error;
+        return false;
+    }
+    m_path = path;
+    m_error.clear();
+
+    const qint64 createdMs = QDateTime::currentMSecsSinceEpoch();
+    m_clock.start();
+    m_epochUs = createdMs * 1000;
+    m_records = m_bytesIn = m_dropped = m_skipped = m_written = 0;
+    m_maxBacklog = 0;
+    if (m_format == Format::KdCap) {
+        QByteArray hdr;
+        KdCap::putHeader(hdr, createdMs);
+        m_written = quint64(qMax<qint64>(0, m_file.write(hdr)));
+    }
+
+    {
+        QMutexLocker lk(&m_lock);
+        m_front.truncate(0);
+        m_front.reserve(kMaxPending); // taps never reallocate
+        m_stop = false;
+    }
+
+    m_thread = QThread::create([this] { run(); });
+    m_thread->setObjectName(QStringLiteral("KeyDash capture writer"));
+    m_thread->start(QThread::LowPriority);
+    m_active.store(true, std::memory_order_release);
+    emit runningChanged(true);
+    return true;
+}
+
+void CaptureRecorder::stop() {
+    if (!m_thread) return;
+    m_active.store(false, std::memory_order_release);
+    {
+        QMutexLocker lk(&m_lock);
+        m_stop = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+    m_file.close();
+    emit runningChanged(false);
+}
+
+bool CaptureRecorder::startSession(const QString &format) {
+    QString dir = m_dir;
+    if (dir.isEmpty())
+        dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/captures");
+    QDir().mkpath(dir);
+    const bool candump = format == QLatin1String("candump");
+    const QString path = dir + QDir::separator() +
+                         QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") +
+                         (candump ? QStringLiteral(".log") : QStringLiteral(".kdcap"));
+    if (!start(path, &m_error)) {
+        qWarning("Could not open capture file %s: %s", qPrintable(path), qPrintable(m_error));
+        return false;
+    }
+    return true;
+}
+
+void CaptureRecorder::setInterfaceName(const QString &iface) {
+    QMutexLocker lk(&m_lock);
+    m_iface = iface.toLatin1();
+}
+
+bool CaptureRecorder::reserveLocked(int n) {
+    if (m_stop) return false;
+    const int backlog = m_front.size() + n;
+    if (backlog > kMaxPending) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (backlog > m_maxBacklog.load(std::memory_order_relaxed))
+        m_maxBacklog.store(backlog, std::memory_order_relaxed);
+    return true;
+}
+
+void CaptureRecorder::recordBytes(const char *data, qint64 n) {
+    if (!m_active.load(std::memory_order_acquire) || n <= 0) return;
+    if (m_format == Format::Candump) { // text format has no byte-stream records
+        m_skipped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const qint64 tUs = m_clock.nsecsElapsed() / 1000;
+    QMutexLocker lk(&m_lock);
+    // Records carry a u16 length; longer reads are split
+    while (n > 0) {
+        KdCap::Record r;
+        r.tUs = tUs;
+        r.len = quint16(qMin<qint64>(n, 0xFFFF));
+        r.kind = KdCap::RxBytes;
+        if (!reserveLocked(KdCap::kRecordBytes + r.len)) return;
+        KdCap::putRecord(m_front, r, data);
+        m_records.fetch_add(1, std::memory_order_relaxed);
+        m_bytesIn.fetch_add(r.len, std::memory_order_relaxed);
+        data += r.len;
+        n -= r.len;
+    }
+    if (m_front.size() >= kSwapThreshold)
+        m_wake.wakeOne();
+}
+
+void CaptureRecorder::recordCan(quint32 id, bool extended, const char *data, int len) {
+    if (!m_active.load(std::memory_order_acquire)) return;
+    const qint64 tUs = m_clock.nsecsElapsed() / 1000;
+    QMutexLocker lk(&m_lock);
+    appendCanLocked(tUs, id, extended, data, len);
+    if (m_front.size() >= kSwapThreshold)
+        m_wake.wakeOne();
+}
+
+void CaptureRecorder::recordCanFrames(const RawCanFrame *frames, int count) {
+    if (!m_active.load(std::memory_order_acquire) || count <= 0) return;
+    const qint64 tUs = m_clock.nsecsElapsed() / 1000;
+    QMutexLocker lk(&m_lock);
+    for (int i = 0; i < count; ++i) {
+        const RawCanFrame &f = frames[i];
+        appendCanLocked(tUs, f.id, f.flags & RawCanFrame::Extended, reinterpret_cast<const char *>(f.data), f.len);
+    }
+    if (m_front.size() >= kSwapThreshold)
+        m_wake.wakeOne();
+}
+
+void CaptureRecorder::appendCanLocked(qint64 tUs, quint32 id, bool extended, const char *data, int len) {
+    len = qBound(0, len, 64);
+    if (m_format == Format::Candump) {
+        if (!reserveLocked(48 + m_iface.size() + 2 * len)) return;
+        appendCandump(tUs, id, extended, data, len);
+    } else {
+        KdCap::Record r;
+        r.tUs = tUs;
+        r.canId = id;
+        r.len = quint16(len);
+        r.kind = KdCap::RxCan;
+        r.flags = extended ? KdCap::CanExtended : 0;
+        if (!reserveLocked(KdCap::kRecordBytes + len)) return;
+        KdCap::putRecord(m_front, r, data);
+    }
+    m_records.fetch_add(1, std::memory_order_relaxed);
+    m_bytesIn.fetch_add(quint64(len), std::memory_order_relaxed);
+}
+
+void CaptureRecorder::appendCandump(qint64 tUs, quint32 id, bool extended, const char *data, int len) {
+    static const char hex[] = "0123456789ABCDEF";
+    const qint64 us = m_epochUs + tUs;
+    char ts[40];
+    const int tsLen = std::snprintf(ts, sizeof ts, "(%lld.%06lld) ",
+                                    static_cast<long long>(us / 1000000),
+                                    static_cast<long long>(us % 1000000));
+    m_front.append(ts, tsLen);
+    m_front.append(m_iface);
+
+    // candump prints 3 id digits for 11-bit frames and 8 for 29-bit ones;
+    // CAN FD frames are "ID##<flags>DATA"
+    char line[1 + 8 + 3 + 128 + 1];
+    char *p = line;
+    *p++ = ' ';
+    for (int shift = (extended ? 28 : 8); shift >= 0; shift -= 4)
+        *p++ = hex[(id >> shift) & 0xF];
+    *p++ = '#';
+    if (len > 8) {
+        *p++ = '#';
+        *p++ = '0';
+    }
+    for (int i = 0; i < len; ++i) {
+        const quint8 b = quint8(data[i]);
+        *p++ = hex[b >> 4];
+        *p++ = hex[b & 0xF];
+    }
+    *p++ = '\n';
+    m_front.append(line, int(p - line));
+}
+
+void CaptureRecorder::run() {
+    QByteArray back;
+    back.reserve(kMaxPending);
+    for (;;) {
+        bool stopping;
+        {
+            QMutexLocker lk(&m_lock);
+            if (!m_stop && m_front.size() < kSwapThreshold)
+                m_wake.wait(&m_lock, kMaxLatencyMs);
+            m_front.swap(back); // both keep their capacity
+            stopping = m_stop;
+        }
+        if (!back.isEmpty()) {
+            const qint64 n = m_file.write(back);
+            if (n > 0) m_written.fetch_add(quint64(n), std::memory_order_relaxed);
+            back.truncate(0);
+        }
+        if (stopping) break;
+    }
+}
+
+QVariantMap CaptureRecorder::stats() const {
+    QVariantMap m;
+    m.insert("running", isRunning());
+    m.insert("path", m_path);
+    m.insert("format", m_format == Format::Candump ? QStringLiteral("candump") : QStringLiteral("kdcap"));
+    m.insert("records", m_records.load(std::memory_order_relaxed));
+    m.insert("bytesIn", m_bytesIn.load(std::memory_order_relaxed));
+    m.insert("dropped", m_dropped.load(std::memory_order_relaxed));
+    m.insert("skipped", m_skipped.load(std::memory_order_relaxed));
+    m.insert("bytesWritten", m_written.load(std::memory_order_relaxed));
+    m.insert("maxBacklog", m_maxBacklog.load(std::memory_order_relaxed));
+    return m;
+}
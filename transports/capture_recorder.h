@@ -0,0 +1,93 @@
+#pragma once
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QVariantMap>
+#include <QWaitCondition>
+#include <atomic>
+#include "core/itransport.h"
+
+class QThread;
+
+// Raw transport capture: every chunk from ITransport::bytesIn/canIn (and the
+// Bluetooth socket in EcuReader) is timestamped and written as-is, so a
+// recording replays through ReplayTransport with the same chunk boundaries
+// and bytes. Two formats:
+//
+//   kdcap    (.kdcap) binary records, see transports/capture_format.h
+//   candump  (.log)   "(sec.usec) iface ID#DATA" text, CAN frames only;
+//                     payloads over 8 bytes as FD lines "ID##<flags>DATA"
+//
+// The taps are thread-safe and cheap: an atomic check when idle, otherwise a
+// short lock and a copy into a preallocated front buffer. A writer thread
+// swaps the buffers and writes the back one. When the writer falls behind,
+// whole records are dropped and counted rather than growing the buffer.
+class CaptureRecorder : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+  public:
+    enum class Format { KdCap, Candump };
+
+    static constexpr int kSwapThreshold = 64 * 1024;   // bytes, wakes the writer
+    static constexpr int kMaxPending    = 1024 * 1024; // bytes, then drop
+    static constexpr int kMaxLatencyMs  = 250;         // writer wakes at least this often
+
+    explicit CaptureRecorder(QObject *parent=nullptr);
+    ~CaptureRecorder();
+
+           // Format from the extension: ".log" is candump, anything else kdcap
+    bool start(const QString &path, QString *error = nullptr);
+    Q_INVOKABLE void stop(); // writes what is queued and closes
+    bool isRunning() const { return m_active.load(std::memory_order_relaxed); }
+
+           // QML: new timestamped file in outputDir(); format "kdcap" or "candump"
+    Q_INVOKABLE bool startSession(const QString &format = QStringLiteral("kdcap"));
+    void setOutputDir(const QString &dir) { m_dir = dir; }
+    QString outputDir() const { return m_dir; }
+    Q_INVOKABLE QString errorString() const { return m_error; }
+
+           // Interface name written into candump lines (default "can0")
+    void setInterfaceName(const QString &iface);
+
+           // running / path / format / records / bytesIn / dropped / skipped /
+           // bytesWritten / maxBacklog
+    Q_INVOKABLE QVariantMap stats() const;
+
+           // Taps, any thread. No-ops unless running.
+    void recordBytes(const char *data, qint64 n);
+    void recordCan(quint32 id, bool extended, const char *data, int len);
+    void recordCan(quint32 id, const QByteArray &payload, bool extended) { recordCan(id, extended, payload.constData(), int(payload.size())); }
+    void recordCanFrames(const RawCanFrame *frames, int count); // one lock per batch
+
+  signals:
+    void runningChanged(bool running);
+
+  private:
+    void run();
+    bool reserveLocked(int n); // m_lock held; false = dropped
+    void appendCanLocked(qint64 tUs, quint32 id, bool extended, const char *data, int len);
+    void appendCandump(qint64 tUs, quint32 id, bool extended, const char *data, int len);
+
+    QThread *m_thread{nullptr};
+    QFile m_file;                  // writer thread only while running
+    QString m_path, m_dir, m_error;
+    Format m_format{Format::KdCap};
+    QElapsedTimer m_clock;         // record time base
+    qint64 m_epochUs{0};           // wall clock at m_clock start (candump)
+
+    QMutex m_lock;
+    QWaitCondition m_wake;
+    QByteArray m_front;            // guarded by m_lock
+    QByteArray m_iface{"can0"};    // guarded by m_lock
+    bool m_stop{true};             // guarded by m_lock
+
+    std::atomic<bool> m_active{false};
+    std::atomic<quint64> m_records{0};
+    std::atomic<quint64> m_bytesIn{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_skipped{0};
+    std::atomic<quint64> m_written{0};
+    std::atomic<int> m_maxBacklog{0};
+};
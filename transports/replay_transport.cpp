@@ -0,0 +1,176 @@
+#include "replay_transport.h"
+#include "capture_format.h"
+#include <QFile>
+
+ReplayTransport::ReplayTransport(const QString &path, double speed, bool loop, QObject *parent)
+    : ITransport(parent), m_path(path), m_speed(qMax(0.0, speed)), m_loop(loop), m_timer(this) {
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &ReplayTransport::pump);
+}
+
+bool ReplayTransport::open() {
+    if (m_open) return true;
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        m_error = f.errorString();
+        return false;
+    }
+    const QByteArray data = f.readAll();
+    m_events.clear();
+    m_payload.clear();
+    const bool ok = KdCap::hasMagic(data) ? loadCapture(data) : loadCandump(data);
+    if (!ok) return false;
+    if (m_events.isEmpty()) {
+        m_error = QStringLiteral("capture has no replayable events");
+        return false;
+    }
+
+    // A capture drives one kind of protocol: CAN if it holds any CAN frames
+    m_kind = Kind::ByteStream;
+    for (const Event &e : std::as_const(m_events))
+        if (e.can) { m_kind = Kind::Can; break; }
+
+    m_open = true;
+    return true;
+}
+
+void ReplayTransport::beginInput() {
+    if (m_open) restart();
+}
+
+void ReplayTransport::close() {
+    m_open = false;
+    m_timer.stop();
+}
+
+qint64 ReplayTransport::write(const QByteArray &data) {
+    if (!m_open) return -1;
+    m_written += quint64(data.size());
+    return data.size();
+}
+
+bool ReplayTransport::loadCapture(const QByteArray &data) {
+    const char *p = data.constData() + KdCap::kHeaderBytes;
+    const char *end = data.constData() + data.size();
+    KdCap::Record r;
+    while (const char *next = KdCap::getRecord(p, end, &r)) {
+        if (r.kind == KdCap::RxBytes || r.kind == KdCap::RxCan) {
+            m_events.append({r.tUs, r.canId, qint32(m_payload.size()), r.len, r.kind == KdCap::RxCan,
+                             bool(r.flags & KdCap::CanExtended)});
+            m_payload.append(p + KdCap::kRecordBytes, r.len);
+        }
+        p = next;
+    }
+    // p != end: truncated tail (capture cut short); keep what was complete
+    return true;
+}
+
+namespace {
+int hexVal(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Whole-string hex (up to 8 digits) -> value
+bool parseHex(const QByteArray &s, quint32 *v) {
+    if (s.isEmpty() || s.size() > 8) return false;
+    *v = 0;
+    for (char c : s) {
+        const int h = hexVal(c);
+        if (h < 0) return false;
+        *v = (*v << 4) | quint32(h);
+    }
+    return true;
+}
+}
+
+bool ReplayTransport::loadCandump(const QByteArray &data) {
+    int bad = 0;
+    for (const QByteArray &raw : data.split('\n')) {
+        const QByteArray line = raw.simplified();
+        if (!line.startsWith('(')) continue;
+        const QList<QByteArray> tok = line.split(' ');
+        // "(sec.usec)" iface "ID#DATA" | "(sec.usec)" iface ID "[len]" B0 B1 ..
+        if (tok.size() < 3 || !tok[0].endsWith(')')) { ++bad; continue; }
+
+        const QByteArray ts = tok[0].mid(1, tok[0].size() - 2);
+        const int dot = ts.indexOf('.');
+        bool okS = false, okU = true;
+        const qint64 sec = ts.left(dot < 0 ? ts.size() : dot).toLongLong(&okS);
+        const qint64 usec = dot < 0 ? 0 : ts.mid(dot + 1, 6).leftJustified(6, '0').toLongLong(&okU);
+        if (!okS || !okU) { ++bad; continue; }
+
+        quint32 id = 0;
+        bool extended = false;
+        QByteArray payload;
+        const QByteArray &frame = tok[2];
+        const int hash = frame.indexOf('#');
+        if (hash >= 0) {
+            if (!parseHex(frame.left(hash), &id)) { ++bad; continue; }
+            extended = hash > 3;
+            QByteArray hex = frame.mid(hash + 1);
+            if (hex.startsWith('R')) continue; // RTR: not replayed
+            if (hex.startsWith('#')) {         // CAN FD: "##<flags nibble><data>"
+                if (hex.size() < 2 || hexVal(hex[1]) < 0) { ++bad; continue; }
+                hex = hex.mid(2);
+            }
+            for (int i = 0; i + 1 < hex.size(); i += 2)
+                payload.append(char(hexVal(hex[i]) << 4 | hexVal(hex[i + 1])));
+        } else {
+            if (!parseHex(frame, &id)) { ++bad; continue; }
+            extended = frame.size() > 3;
+            for (int i = 4; i < tok.size(); ++i) { // tok[3] is "[len]"
+                quint32 b;
+                if (tok[i].size() == 2 && parseHex(tok[i], &b)) payload.append(char(b));
+            }
+        }
+        m_events.append({sec * 1000000 + usec, id, qint32(m_payload.size()), quint16(payload.size()), true, extended});
+        m_payload += payload;
+    }
+    if (m_events.isEmpty() && bad) {
+        m_error = QStringLiteral("not a .kdcap or candump log (%1 unreadable lines)").arg(bad);
+        return false;
+    }
+    return true;
+}
+
+void ReplayTransport::restart() {
+    m_next = 0;
+    m_t0Us = m_events.first().tUs;
+    m_clock.start();
+    m_timer.start(0);
+}
+
+void ReplayTransport::pump() {
+    int burst = 0;
+    while (m_open && m_next < m_events.size()) {
+        const Event &e = m_events[m_next];
+        if (m_speed > 0.0) {
+            const qint64 dueUs = qint64(double(e.tUs - m_t0Us) / m_speed);
+            const qint64 nowUs = m_clock.nsecsElapsed() / 1000;
+            // Events due within the timer's 1 ms resolution go out now;
+            // waiting for them would re-enter here with a 0 ms timer
+            if (dueUs - nowUs >= 1000) {
+                m_timer.start(int((dueUs - nowUs) / 1000));
+                return;
+            }
+        } else if (burst == kFastBurst) {
+            m_timer.start(0); // yield to the event loop
+            return;
+        }
+
+        // Copy: receivers may keep the buffer (e.g. append to their own)
+        const QByteArray payload(m_payload.constData() + e.offset, e.len);
+        ++m_next;
+        ++burst;
+        if (e.can) emit canIn(e.canId, payload, e.extended);
+        else       emit bytesIn(payload);
+    }
+    if (!m_open) return;
+
+    if (m_loop) restart();
+    else        emit finished();
+}
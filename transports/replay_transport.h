@@ -0,0 +1,76 @@
+#pragma once
+#include "core/itransport.h"
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+// Plays a recorded capture back through the ITransport signals, so any
+// protocol can be driven deterministically without hardware:
+//
+//   .kdcap          KeyDash capture (see capture_format.h): serial chunks
+//                   as bytesIn(), CAN frames as canIn()
+//   anything else   candump log, "(sec.usec) can0 123#DEADBEEF" (CAN FD
+//                   "123##<flags>DATA") or the "-ta" column format
+//                   "(sec.usec) can0 123 [4] DE AD BE EF"; 8-digit ids are
+//                   29-bit, as candump prints them
+//
+// Pacing: speed 1.0 replays in real time, N replays N× faster, 0 emits as
+// fast as possible (in bursts, so the I/O thread's event loop keeps
+// running). The file is loaded completely in open(); playback starts in
+// beginInput(), once every receiver is connected. Writes are accepted
+// and dropped (a replayed ELM327 session still answers on its own
+// timeline). Lives on the I/O thread like the other transports.
+class ReplayTransport : public ITransport {
+    Q_OBJECT
+  public:
+    static constexpr int kFastBurst = 256; // events per event-loop turn at speed 0
+
+    explicit ReplayTransport(const QString &path, double speed = 1.0, bool loop = false,
+                             QObject *parent=nullptr);
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return m_open; }
+    Kind kind() const override { return m_kind; }
+    void beginInput() override;
+    qint64 write(const QByteArray &data) override;
+
+    QString errorString() const { return m_error; }
+    int     eventCount() const { return m_events.size(); }
+    qint64  durationUs() const { return m_events.isEmpty() ? 0 : m_events.last().tUs - m_events.first().tUs; }
+    int     position() const { return m_next; }
+    quint64 bytesWritten() const { return m_written; }
+
+  signals:
+    void finished(); // last event emitted (not emitted when looping)
+
+  private:
+    struct Event {
+        qint64  tUs;
+        quint32 canId;
+        qint32  offset; // into m_payload
+        quint16 len;
+        bool    can;
+        bool    extended; // 29-bit CAN id
+    };
+
+    bool loadCapture(const QByteArray &data);
+    bool loadCandump(const QByteArray &data);
+    void restart();
+    void pump();
+
+    QString m_path;
+    double  m_speed{1.0};
+    bool    m_loop{false};
+    bool    m_open{false};
+    Kind    m_kind{Kind::ByteStream};
+    QString m_error;
+
+    QVector<Event> m_events;
+    QByteArray m_payload;   // all payload bytes, back to back
+    int m_next{0};
+    qint64 m_t0Us{0};       // first event's capture time
+    QElapsedTimer m_clock;  // replay time since restart()
+    QTimer m_timer;
+    quint64 m_written{0};
+};
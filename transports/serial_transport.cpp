@@ -24,5 +24,8 @@ qint64 SerialTransport::write(const QByteArray &data) {
 
 void SerialTransport::onReadyRead() {
     const QByteArray buf = m_sp.readAll();
-    if (!buf.isEmpty()) emit bytesIn(buf);
+    if (buf.isEmpty()) return;
+    m_reads->add();
+    m_bytesIn->add(quint64(buf.size()));
+    emit bytesIn(buf);
 }
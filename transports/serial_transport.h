@@ -1,23 +1,26 @@
 #pragma once
 #include "core/itransport.h"
+#include "core/pipeline_metrics.h"
 #include <QSerialPort>
 
 class SerialTransport : public ITransport {
     Q_OBJECT
   public:
     explicit SerialTransport(const QString &portName, int baud, QObject *parent=nullptr)
-        : ITransport(parent), m_portName(portName), m_baud(baud) {}
+        : ITransport(parent), m_portName(portName), m_baud(baud), m_sp(this) {}
 
     bool open() override;
     void close() override;
     bool isOpen() const override { return m_sp.isOpen(); }
 
-    qint64 write(const QByteArray &data);
+    qint64 write(const QByteArray &data) override;
 
   private:
     QString m_portName;
     int m_baud{115200};
     QSerialPort m_sp;
+    PipelineMetrics::Counter *m_bytesIn = PipelineMetrics::instance().counter("serial.bytesIn");
+    PipelineMetrics::Counter *m_reads   = PipelineMetrics::instance().counter("serial.reads");
 
   private slots:
     void onReadyRead();
@@ -0,0 +1,199 @@
+#include "socketcan_transport.h"
+#include <QSocketNotifier>
+#include <QVarLengthArray>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/can.h>
+#include <linux/can/error.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+constexpr int kMaxRounds = 8;  // recvmmsg() calls per socket per wakeup (level-triggered)
+constexpr int kMaxEvents = 16;
+}
+
+struct SocketCanTransport::RecvBuffers {
+    mmsghdr     msgs[kBatch];
+    iovec       iov[kBatch];
+    can_frame   frames[kBatch];
+
+    RecvBuffers() : msgs{}, iov{}, frames{} {
+        for (int i = 0; i < kBatch; ++i) {
+            iov[i].iov_base = &frames[i];
+            iov[i].iov_len = sizeof(can_frame);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+};
+#else
+struct SocketCanTransport::RecvBuffers {};
+#endif
+
+SocketCanTransport::SocketCanTransport(const QStringList &ifaces, QObject *parent)
+    : ITransport(parent), m_ifaces(ifaces), m_rx(new RecvBuffers) {
+    m_out.resize(kBatch);
+}
+
+SocketCanTransport::~SocketCanTransport() {
+    close();
+    delete m_rx;
+}
+
+#ifdef Q_OS_LINUX
+
+bool SocketCanTransport::open() {
+    if (isOpen()) return true;
+    if (m_ifaces.isEmpty()) {
+        m_error = QStringLiteral("no CAN interface given");
+        return false;
+    }
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll < 0) {
+        m_error = qt_error_string(errno);
+        return false;
+    }
+
+    for (int i = 0; i < m_ifaces.size(); ++i) {
+        const QByteArray name = m_ifaces[i].toLocal8Bit();
+        auto fail = [&](const char *what) {
+            m_error = QStringLiteral("%1: %2 (%3)").arg(m_ifaces[i], QLatin1String(what), qt_error_string(errno));
+            close();
+            return false;
+        };
+        const int s = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+        if (s < 0) return fail("socket");
+        m_socks.append(s);
+
+        // CAN_RAW_FD_FRAMES stays off: the DBC decoder and candump replay
+        // handle classic 8-byte frames only
+        const can_err_mask_t errs = CAN_ERR_BUSOFF | CAN_ERR_CRTL | CAN_ERR_RESTARTED | CAN_ERR_TX_TIMEOUT;
+        setsockopt(s, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &errs, sizeof errs);
+        applyFilters(s); // before bind: no unfiltered window
+
+        sockaddr_can addr{};
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = int(if_nametoindex(name.constData()));
+        if (!addr.can_ifindex) return fail("no such interface");
+        if (bind(s, reinterpret_cast<sockaddr *>(&addr), sizeof addr) < 0) return fail("bind");
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u32 = quint32(i);
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, s, &ev) < 0) return fail("epoll_ctl");
+    }
+
+    m_notifier = new QSocketNotifier(m_epoll, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &SocketCanTransport::onReadable);
+    m_error.clear();
+    return true;
+}
+
+void SocketCanTransport::close() {
+    delete m_notifier;
+    m_notifier = nullptr;
+    for (int s : std::as_const(m_socks))
+        ::close(s);
+    m_socks.clear();
+    if (m_epoll >= 0) ::close(m_epoll);
+    m_epoll = -1;
+}
+
+void SocketCanTransport::setCanIds(const QVector<CanId> &ids) {
+    m_filters = computeCanFilters(ids, kMaxFilters);
+    for (int s : std::as_const(m_socks))
+        applyFilters(s);
+}
+
+void SocketCanTransport::applyFilters(int fd) {
+    // Masking the EFF and RTR flags makes each filter match its id format
+    // and data frames only. No filters: the kernel default, accept all.
+    QVarLengthArray<can_filter, kMaxFilters> fs;
+    for (const CanFilter &f : std::as_const(m_filters)) {
+        can_filter k;
+        k.can_id   = f.id | (f.extended ? CAN_EFF_FLAG : 0);
+        k.can_mask = f.mask | CAN_EFF_FLAG | CAN_RTR_FLAG;
+        fs.append(k);
+    }
+    if (fs.isEmpty())
+        fs.append(can_filter{0, 0});
+    setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, fs.constData(), socklen_t(fs.size() * sizeof(can_filter)));
+}
+
+bool SocketCanTransport::write(quint32 id, const QByteArray &payload) {
+    if (m_socks.isEmpty()) return false;
+    can_frame f{};
+    f.can_id = id > CAN_SFF_MASK ? ((id & CAN_EFF_MASK) | CAN_EFF_FLAG) : id;
+    f.can_dlc = quint8(qMin(int(payload.size()), CAN_MAX_DLEN));
+    std::memcpy(f.data, payload.constData(), f.can_dlc);
+    return ::write(m_socks.first(), &f, sizeof f) == qint64(sizeof f);
+}
+
+void SocketCanTransport::onReadable() {
+    epoll_event ev[kMaxEvents];
+    const int n = epoll_wait(m_epoll, ev, kMaxEvents, 0);
+    for (int i = 0; i < n; ++i) {
+        const int idx = int(ev[i].data.u32);
+        if (idx < m_socks.size())
+            drain(m_socks[idx], idx);
+    }
+}
+
+int SocketCanTransport::drain(int sock, int ifaceIndex) {
+    int total = 0;
+    for (int round = 0; round < kMaxRounds; ++round) {
+        const int got = recvmmsg(sock, m_rx->msgs, kBatch, MSG_DONTWAIT, nullptr);
+        if (got <= 0) break; // EAGAIN: drained
+
+        int n = 0;
+        quint64 bytes = 0;
+        for (int i = 0; i < got; ++i) {
+            const can_frame &k = m_rx->frames[i];
+            if (k.can_id & CAN_ERR_FLAG) {
+                m_errors->add();
+                continue;
+            }
+            RawCanFrame &f = m_out[n++];
+            const bool ext = k.can_id & CAN_EFF_FLAG;
+            f.id    = k.can_id & (ext ? CAN_EFF_MASK : CAN_SFF_MASK);
+            f.flags = quint8((ext ? RawCanFrame::Extended : 0) |
+                             ((k.can_id & CAN_RTR_FLAG) ? RawCanFrame::Rtr : 0));
+            f.len   = quint8(qMin<int>(k.can_dlc, CAN_MAX_DLEN));
+            f.iface = quint8(ifaceIndex);
+            std::memcpy(f.data, k.data, f.len);
+            bytes += f.len;
+        }
+        m_batches->add();
+        m_batchMax->set(got);
+        if (n) {
+            m_framesIn->add(quint64(n));
+            m_bytesIn->add(bytes);
+            emit canFrames(m_out.constData(), n);
+        }
+        total += n;
+        if (got < kBatch) break;
+    }
+    return total;
+}
+
+#else // !Q_OS_LINUX
+
+bool SocketCanTransport::open() {
+    m_error = QStringLiteral("SocketCAN is only available on Linux");
+    return false;
+}
+void SocketCanTransport::close() {}
+void SocketCanTransport::setCanIds(const QVector<CanId> &ids) { m_filters = computeCanFilters(ids, kMaxFilters); }
+void SocketCanTransport::applyFilters(int) {}
+bool SocketCanTransport::write(quint32, const QByteArray &) { return false; }
+void SocketCanTransport::onReadable() {}
+int SocketCanTransport::drain(int, int) { return 0; }
+
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+#include "core/itransport.h"
+#include "core/pipeline_metrics.h"
+#include "transports/can_filter.h"
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+class QSocketNotifier;
+
+// Linux-native SocketCAN without the QtSerialBus plugin layer.
+//
+// One CAN_RAW socket per interface (classic frames), all registered with a
+// single epoll instance whose fd sits in the I/O thread's event loop. When
+// it fires, each ready socket is drained with recvmmsg() in batches of
+// kBatch into preallocated kernel frame structs, converted in place into a
+// preallocated RawCanFrame array and handed downstream with one
+// canFrames() emission per batch: no QCanBusFrame, no QByteArray payloads,
+// no allocation per frame. setCanIds() installs CAN_RAW_FILTER on every
+// socket (see computeCanFilters()).
+//
+// On other platforms open() fails.
+class SocketCanTransport : public ITransport {
+    Q_OBJECT
+  public:
+    static constexpr int kBatch      = 64; // frames per recvmmsg() call
+    static constexpr int kMaxFilters = 64;
+
+           // ifaces: "can0" or several, e.g. {"can0", "can1"}; RawCanFrame::iface
+           // is the index in this list
+    explicit SocketCanTransport(const QStringList &ifaces, QObject *parent=nullptr);
+    ~SocketCanTransport() override;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return m_epoll >= 0; }
+    Kind kind() const override { return Kind::Can; }
+    void setCanIds(const QVector<CanId> &ids) override;
+
+    QStringList interfaces() const { return m_ifaces; }
+    QString errorString() const { return m_error; }
+
+           // Classic frame on the first interface
+    using ITransport::write;
+    bool write(quint32 id, const QByteArray &payload);
+
+  private:
+    struct RecvBuffers; // kernel-side mmsghdr/iovec/can_frame arrays
+
+    void applyFilters(int fd);
+    int drain(int sock, int ifaceIndex); // frames delivered
+
+    QStringList m_ifaces;
+    QVector<int> m_socks;
+    int m_epoll{-1};
+    QSocketNotifier *m_notifier{nullptr};
+    RecvBuffers *m_rx{nullptr};
+    QVector<RawCanFrame> m_out; // kBatch frames, reused
+    QVector<CanFilter> m_filters;
+    QString m_error;
+
+    PipelineMetrics::Counter *m_framesIn = PipelineMetrics::instance().counter("socketcan.framesIn");
+    PipelineMetrics::Counter *m_bytesIn  = PipelineMetrics::instance().counter("socketcan.bytesIn");
+    PipelineMetrics::Counter *m_batches  = PipelineMetrics::instance().counter("socketcan.batches");
+    PipelineMetrics::Counter *m_errors   = PipelineMetrics::instance().counter("socketcan.errorFrames");
+    PipelineMetrics::Gauge   *m_batchMax = PipelineMetrics::instance().gauge("socketcan.batchSize");
+
+  private slots:
+    void onReadable();
+};